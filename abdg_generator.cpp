@@ -0,0 +1,297 @@
+/*
+Synthetic Agent Behavior Dependency Graph (ABDG) generator for scalability benchmarks
+Input: Options (all optional)
+        - -n nodes: number of vertices, n (default 1000; up to 10^7 and beyond)
+        - -g agents: number of agents the R, A, P and J nodes are spread over (default n / 10)
+        - -d degree: edges per vertex (default 1.26, as in the case studies)
+        - -c cycle_density: share of edges running against the layering of the nodes, in [0, 1]
+          (default 0.1; 0 gives an almost acyclic ABDG)
+        - -m w1,w2,w3,w4,w5,w6: relative weights of the edge types 1-6 (default: the mix of the
+          case studies)
+        - -s seed: random seed (default 1)
+        - -o output_file: ABDG file (default standard output)
+        - -q query_file: also write a batch query file of random slice criteria
+        - -k queries: number of queries in the query file (default 1000)
+        - -t tau: threshold of the queries (default 0.15)
+Output: 1. The ABDG in the input format of the slicers
+        - Number of Vertices, n; Vertices S0, R1.., A1.., P1.., J1..; Number of Edges, e;
+          Edges as tail <space> head <space> edge_type
+        2. With -q, one query per line: criterion <space> tau <space> dsabm
+Model: Every edge follows a (type, tail kind, head kind) pattern drawn with the frequency it has
+       in the case studies (CMS, FMS, IHG, IHS, PTY, TMS and input_file.txt). The nodes of every
+       kind are split into contiguous per-agent blocks; edges of types 2 and 5 (inter-agent) join
+       two different agents, the other types stay inside one agent. Inside a block, the position of
+       a node is its layer: edges run from lower to higher layers except for a share c of them,
+       which close cycles.
+*/
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <random>
+#include <algorithm>
+using namespace std;
+
+// Node kinds, in the order of the sorted vertex list
+enum Kind { S, R, A, P, J, KINDS };
+
+// Share of the R, A, P and J nodes in the case studies (86, 132, 32 and 28 nodes)
+const double KIND_SHARE[KINDS] = {0, 86, 132, 32, 28};
+
+// Edge patterns of the case studies: edge type, tail kind, head kind and number of occurrences
+struct Pattern {
+    int type;
+    Kind tail, head;
+    double count;
+};
+
+const Pattern CASE_STUDY_PATTERNS[] = {
+    {1, A, A, 13}, {1, A, J, 33}, {1, A, R, 16}, {1, A, S, 4}, {1, J, A, 4}, {1, J, J, 4},
+    {1, J, R, 16}, {1, J, S, 4}, {1, P, A, 15}, {1, P, J, 9}, {1, R, A, 48}, {1, R, J, 2},
+    {1, R, R, 3}, {1, S, R, 24}, {2, A, R, 24}, {2, R, A, 11}, {3, A, P, 4}, {4, P, A, 2},
+    {4, P, J, 1}, {4, P, R, 1}, {5, A, P, 27}, {5, A, R, 14}, {5, P, R, 10}, {5, R, P, 1},
+    {6, A, A, 9}, {6, A, R, 14}, {6, P, A, 1}, {6, P, R, 3}, {6, R, A, 41}
+};
+
+const char KIND_NAME[KINDS] = {'S', 'R', 'A', 'P', 'J'};
+
+class Generator{
+        // Number of vertices and edges
+        int64_t n, e;
+        // Number of agents
+        int64_t agents;
+        // Share of cycle-closing edges
+        double cycles;
+        // Number of nodes of every kind, and the index of the first one
+        int64_t count[KINDS], first[KINDS];
+        // Usable patterns and the cumulative distribution of their weights
+        vector<Pattern> patterns;
+        vector<double> cumulative;
+        mt19937_64 rng;
+        // Method to draw a uniform number in [0, 1)
+        double uniform(){
+            return (rng() >> 11) * (1.0 / 9007199254740992.0);
+        }
+        // Method to draw an agent other than g (g itself if there is only one)
+        int64_t other_agent(int64_t g){
+            if(agents == 1)
+                return g;
+            int64_t h = rng() % (agents - 1);
+            return h >= g ? h + 1 : h;
+        }
+        // Method to map a layer in [0, 1) to a node of the given kind and agent
+        int64_t node(Kind k, int64_t g, double layer);
+        // Method to append the name of the node with the given index to the buffer
+        void append_name(string& out, int64_t v) const;
+    public:
+        // Constructor
+        Generator(int64_t n, int64_t agents, double degree, double cycles, const vector<double>& mix, uint64_t seed);
+        // Method to write the ABDG
+        void write_graph(FILE* out);
+        // Method to write a batch query file of random slice criteria
+        void write_queries(const string& file, int64_t queries, double tau);
+        // Method to report the composition of the ABDG
+        void summary(ostream& os) const;
+};
+
+// Constructor Definition
+Generator::Generator(int64_t n, int64_t agents, double degree, double cycles, const vector<double>& mix, uint64_t seed)
+    : n(n), agents(agents), cycles(cycles), rng(seed){
+    e = llround(n * degree);
+    // Split the n - 1 non-S0 nodes by the case-study shares; J takes the rest
+    double total = KIND_SHARE[R] + KIND_SHARE[A] + KIND_SHARE[P] + KIND_SHARE[J];
+    count[S] = 1;
+    count[J] = n - 1;
+    for(int k = R; k < J; k++){
+        count[k] = llround((n - 1) * KIND_SHARE[k] / total);
+        count[J] -= count[k];
+    }
+    first[S] = 0;
+    for(int k = R; k < KINDS; k++)
+        first[k] = first[k - 1] + count[k - 1];
+
+    // Rescale the patterns of every edge type to the requested mix
+    double per_type[7] = {0};
+    for(const Pattern& pt : CASE_STUDY_PATTERNS)
+        per_type[pt.type] += pt.count;
+    double sum = 0;
+    for(const Pattern& pt : CASE_STUDY_PATTERNS){
+        if(count[pt.tail] == 0 || count[pt.head] == 0 || mix[pt.type] <= 0)
+            continue;
+        if(pt.tail == pt.head && count[pt.tail] == 1)
+            continue;
+        patterns.push_back(pt);
+        patterns.back().count = mix[pt.type] * pt.count / per_type[pt.type];
+        sum += patterns.back().count;
+        cumulative.push_back(sum);
+    }
+    if(patterns.empty() || n < 2){
+        cerr << "Error: No edge can be generated with the given node count and edge mix"<<endl;
+        exit(1);
+    }
+}
+
+// Method definition for node(): the nodes of kind k owned by agent g form a contiguous block;
+// a block can be empty when there are more agents than nodes of a kind, in which case every
+// node of the kind is a candidate
+int64_t Generator::node(Kind k, int64_t g, double layer){
+    int64_t lo = count[k] * g / agents, hi = count[k] * (g + 1) / agents;
+    if(lo == hi){
+        lo = 0;
+        hi = count[k];
+    }
+    return first[k] + lo + min<int64_t>(hi - lo - 1, layer * (hi - lo));
+}
+
+// Method definition for append_name()
+void Generator::append_name(string& out, int64_t v) const{
+    int k = KINDS - 1;
+    while(v < first[k])
+        k--;
+    out += KIND_NAME[k];
+    out += to_string(k == S ? 0 : v - first[k] + 1);
+}
+
+// Method definition for write_graph(): edges are drawn pattern by pattern and written through
+// one buffer, so that 10^7-node graphs are generated in seconds
+void Generator::write_graph(FILE* out){
+    string buffer = to_string(n) + "\n";
+    for(int64_t v = 0; v < n; v++){
+        append_name(buffer, v);
+        buffer += v + 1 < n ? ' ' : '\n';
+        if(buffer.size() > (1 << 20)){
+            fwrite(buffer.data(), 1, buffer.size(), out);
+            buffer.clear();
+        }
+    }
+    buffer += to_string(e) + "\n";
+    for(int64_t i = 0; i < e; i++){
+        const Pattern& pt = patterns[lower_bound(cumulative.begin(), cumulative.end(), uniform() * cumulative.back())
+                                     - cumulative.begin()];
+        int64_t tail, head;
+        for(int attempt = 0;; attempt++){
+            int64_t g = rng() % agents;
+            int64_t h = pt.type == 2 || pt.type == 5 ? other_agent(g) : g;
+            // Layered by default, against the layers for a share of the edges
+            double x = uniform(), y = uniform();
+            if((x > y) != (uniform() < cycles))
+                swap(x, y);
+            tail = node(pt.tail, g, x);
+            // Agents owning a single node of a kind cannot hold an edge inside that kind:
+            // after a few self-loops the head is taken from the whole kind instead
+            head = attempt < 8 ? node(pt.head, h, y) : first[pt.head] + int64_t(rng() % count[pt.head]);
+            if(tail != head)
+                break;
+        }
+        append_name(buffer, tail);
+        buffer += ' ';
+        append_name(buffer, head);
+        buffer += ' ';
+        buffer += char('0' + pt.type);
+        buffer += '\n';
+        if(buffer.size() > (1 << 20)){
+            fwrite(buffer.data(), 1, buffer.size(), out);
+            buffer.clear();
+        }
+    }
+    fwrite(buffer.data(), 1, buffer.size(), out);
+}
+
+// Method definition for write_queries()
+void Generator::write_queries(const string& file, int64_t queries, double tau){
+    ofstream qs(file);
+    if(!qs.is_open()){
+        cerr << "Error: Could not open query file "<<file<<endl;
+        exit(1);
+    }
+    string name;
+    for(int64_t i = 0; i < queries; i++){
+        name.clear();
+        append_name(name, rng() % n);
+        qs<<name<<" "<<tau<<" dsabm\n";
+    }
+}
+
+// Method definition for summary()
+void Generator::summary(ostream& os) const{
+    os<<n<<" nodes (";
+    for(int k = S; k < KINDS; k++)
+        os<<count[k]<<" "<<KIND_NAME[k]<<(k + 1 < KINDS ? ", " : "), ");
+    os<<e<<" edges, "<<agents<<" agents"<<endl;
+}
+
+int main(int argc, char *argv[]){
+    int64_t n = 1000, agents = 0, queries = 1000;
+    double degree = 1.26, cycles = 0.1, tau = 0.15;
+    uint64_t seed = 1;
+    // Default mix: the number of edges of every type in the case studies
+    vector<double> mix = {0, 196, 35, 4, 4, 52, 68};
+    string output_file, query_file;
+    for(int arg = 1; arg < argc; arg += 2){
+        string option = argv[arg];
+        if(arg + 1 == argc){
+            cerr << "Error: Missing value for option "<<option<<endl;
+            exit(1);
+        }
+        string value = argv[arg + 1];
+        if(option == "-n")
+            n = atoll(value.c_str());
+        else if(option == "-g")
+            agents = atoll(value.c_str());
+        else if(option == "-d")
+            degree = atof(value.c_str());
+        else if(option == "-c")
+            cycles = atof(value.c_str());
+        else if(option == "-s")
+            seed = strtoull(value.c_str(), nullptr, 10);
+        else if(option == "-o")
+            output_file = value;
+        else if(option == "-q")
+            query_file = value;
+        else if(option == "-k")
+            queries = atoll(value.c_str());
+        else if(option == "-t")
+            tau = atof(value.c_str());
+        else if(option == "-m"){
+            istringstream ms(value);
+            string weight;
+            for(int type = 1; type <= 6; type++){
+                if(!getline(ms, weight, ',')){
+                    cerr << "Error: -m expects six comma-separated weights"<<endl;
+                    exit(1);
+                }
+                mix[type] = atof(weight.c_str());
+            }
+        }
+        else{
+            cerr << "Error: Unknown option "<<option<<endl;
+            exit(1);
+        }
+    }
+    if(n < 2 || degree < 0 || cycles < 0 || cycles > 1){
+        cerr << "Error: Expected n >= 2, degree >= 0 and cycle density in [0, 1]"<<endl;
+        exit(1);
+    }
+    if(agents <= 0)
+        agents = max<int64_t>(1, n / 10);
+
+    Generator gen(n, agents, degree, cycles, mix, seed);
+    FILE* out = stdout;
+    if(!output_file.empty() && !(out = fopen(output_file.c_str(), "wb"))){
+        cerr << "Error: Could not open output file "<<output_file<<endl;
+        exit(1);
+    }
+    gen.write_graph(out);
+    if(out != stdout)
+        fclose(out);
+    if(!query_file.empty())
+        gen.write_queries(query_file, queries, tau);
+    gen.summary(cerr);
+    return 0;
+}
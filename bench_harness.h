@@ -0,0 +1,214 @@
+/*
+Microbenchmark harness shared by the benchmark modes of the slicers
+        - Every measured call is repeated: warmup runs first (discarded), then the timed iterations
+        - The measuring thread is pinned to one CPU, so that migrations do not pollute the samples
+        - Per call: min, median and p99 latency, with a 95% confidence interval for the median
+          (distribution-free, from the binomial order statistics)
+        - Where the kernel allows it (Linux perf_event_open), the median cycles, cache misses and
+          branch misses of a call; elsewhere the counters are reported as unavailable
+*/
+
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+// Iterations of every measured call and the CPU the harness runs on (-1: no pinning)
+struct BenchConfig {
+    int warmup = 10;
+    int iterations = 100;
+    int cpu = 0;
+};
+
+// Latency statistics of one measured call, in microseconds, and the median hardware counters
+struct BenchResult {
+    double min, median, p99, ci_low, ci_high;
+    bool has_counters;
+    double cycles, cache_misses, branch_misses;
+};
+
+// Pins the calling thread to the given CPU; false if the platform refuses
+inline bool pin_thread(int cpu){
+    if(cpu < 0)
+        return false;
+#ifdef _WIN32
+    return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+// Cycles, cache misses and branch misses of the calling thread, read as one perf event group
+class PerfCounters{
+        static const int EVENTS = 3;
+        int fd[EVENTS];
+        bool ok;
+    public:
+        PerfCounters() : ok(false){
+            for(int i = 0; i < EVENTS; i++)
+                fd[i] = -1;
+#ifdef __linux__
+            const uint64_t config[EVENTS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_CACHE_MISSES,
+                                             PERF_COUNT_HW_BRANCH_MISSES};
+            for(int i = 0; i < EVENTS; i++){
+                perf_event_attr attr;
+                memset(&attr, 0, sizeof(attr));
+                attr.size = sizeof(attr);
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = config[i];
+                attr.disabled = i == 0;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_GROUP;
+                fd[i] = syscall(__NR_perf_event_open, &attr, 0, -1, i == 0 ? -1 : fd[0], 0);
+                if(fd[i] < 0)
+                    return;
+            }
+            ok = true;
+#endif
+        }
+        ~PerfCounters(){
+#ifdef __linux__
+            for(int i = 0; i < EVENTS; i++)
+                if(fd[i] >= 0)
+                    close(fd[i]);
+#endif
+        }
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+        bool available() const{
+            return ok;
+        }
+        void start(){
+#ifdef __linux__
+            if(ok){
+                ioctl(fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                ioctl(fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            }
+#endif
+        }
+        // Stops counting and stores the counts of the three events
+        void stop(double counts[EVENTS]){
+            for(int i = 0; i < EVENTS; i++)
+                counts[i] = 0;
+#ifdef __linux__
+            if(ok){
+                ioctl(fd[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+                uint64_t group[1 + EVENTS];
+                if(read(fd[0], group, sizeof(group)) == ssize_t(sizeof(group)))
+                    for(int i = 0; i < EVENTS; i++)
+                        counts[i] = double(group[1 + i]);
+            }
+#endif
+        }
+};
+
+// Value at the given 1-based rank of an ascending sample, clamped to the sample
+inline double rank_value(const std::vector<double>& sorted, double rank){
+    long k = std::min<long>(std::max<long>(1, long(rank)), long(sorted.size()));
+    return sorted[k - 1];
+}
+
+// Median of an unsorted sample (sorts it)
+inline double median_of(std::vector<double>& sample){
+    std::sort(sample.begin(), sample.end());
+    size_t m = sample.size();
+    return m % 2 ? sample[m / 2] : (sample[m / 2 - 1] + sample[m / 2]) / 2;
+}
+
+// Runs f for the warmup and the timed iterations of the configuration
+template <class F>
+BenchResult bench(F&& f, const BenchConfig& config, PerfCounters& counters){
+    for(int i = 0; i < config.warmup; i++)
+        f();
+    int m = std::max(1, config.iterations);
+    std::vector<double> time(m), cycles(m), cache(m), branch(m);
+    double counts[3];
+    for(int i = 0; i < m; i++){
+        counters.start();
+        auto start = std::chrono::steady_clock::now();
+        f();
+        auto stop = std::chrono::steady_clock::now();
+        counters.stop(counts);
+        time[i] = std::chrono::duration<double, std::micro>(stop - start).count();
+        cycles[i] = counts[0];
+        cache[i] = counts[1];
+        branch[i] = counts[2];
+    }
+    BenchResult result;
+    result.median = median_of(time);
+    result.min = time[0];
+    result.p99 = rank_value(time, std::ceil(0.99 * m));
+    // Ranks m/2 -+ 1.96 sqrt(m)/2 bound the median with 95% confidence
+    double half_width = 0.98 * std::sqrt(double(m));
+    result.ci_low = rank_value(time, std::floor(m / 2.0 - half_width));
+    result.ci_high = rank_value(time, std::ceil(m / 2.0 + 1 + half_width));
+    result.has_counters = counters.available();
+    result.cycles = median_of(cycles);
+    result.cache_misses = median_of(cache);
+    result.branch_misses = median_of(branch);
+    return result;
+}
+
+// Column header of the per-call lines, preceded by the configuration
+inline void print_bench_header(std::ostream& os, const BenchConfig& config, bool pinned, const PerfCounters& counters){
+    os<<"# warmup "<<config.warmup<<", iterations "<<config.iterations<<", cpu "
+      <<(pinned ? std::to_string(config.cpu) : std::string("unpinned"))<<", counters "
+      <<(counters.available() ? "on" : "unavailable")<<"\n";
+    os<<"# label min_us median_us p99_us ci95_low_us ci95_high_us cycles cache_misses branch_misses\n";
+}
+
+// One line per measured call
+inline void print_bench_result(std::ostream& os, const std::string& label, const BenchResult& r){
+    os<<label<<std::fixed<<std::setprecision(3)<<" "<<r.min<<" "<<r.median<<" "<<r.p99<<" "<<r.ci_low<<" "<<r.ci_high;
+    if(r.has_counters)
+        os<<std::setprecision(0)<<" "<<r.cycles<<" "<<r.cache_misses<<" "<<r.branch_misses;
+    else
+        os<<" n/a n/a n/a";
+    os<<std::defaultfloat<<std::setprecision(6)<<"\n";
+}
+
+// Summary over all calls: the median and the worst of the per-call medians and p99s
+inline void print_bench_summary(std::ostream& os, const std::vector<BenchResult>& results){
+    if(results.empty())
+        return;
+    std::vector<double> medians, p99s;
+    for(const BenchResult& r : results){
+        medians.push_back(r.median);
+        p99s.push_back(r.p99);
+    }
+    double worst_p99 = *std::max_element(p99s.begin(), p99s.end());
+    os<<std::fixed<<std::setprecision(3)<<"# summary: "<<results.size()<<" calls, median of medians "
+      <<median_of(medians)<<" us, max median "<<medians.back()<<" us, median p99 "<<median_of(p99s)
+      <<" us, max p99 "<<worst_p99<<" us"<<std::defaultfloat<<std::setprecision(6)<<"\n";
+}
+
+#endif
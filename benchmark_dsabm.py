@@ -0,0 +1,198 @@
+import argparse
+import os
+import subprocess
+import sys
+import time
+
+# Scalability benchmark of the slicing backends on synthetic ABDGs (see abdg_generator.cpp):
+# load time, per-query latency percentiles and peak memory of every backend at every size.
+#   matrix     - dsabm_dg_2 (dependency matrix, interactive input fed through stdin)
+#   list       - dsabm_list_fin (Incident-Dependency List, multi-criteria DSABM)
+#   integrated - dsabm_integrated, unweighted DSABM
+#   pruned     - dsabm_integrated, relevance-pruned DSABM at the query threshold
+# With --micro, every node of every case study is measured instead with the in-process harness
+# of the backends (bench_harness.h: warmup, pinned iterations, min/median/p99, counters);
+# list_time (dsabm_list_fin_time, the scalar list DSABM) joins the backends there.
+
+def run_measured(cmd, stdin_path=None):
+    """Runs cmd with its output discarded; returns (wall seconds, peak RSS in MB or None)."""
+    stdin = open(stdin_path, 'rb') if stdin_path else subprocess.DEVNULL
+    start = time.perf_counter()
+    proc = subprocess.Popen(cmd, stdin=stdin, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    if hasattr(os, 'wait4'):
+        _, status, usage = os.wait4(proc.pid, 0)
+        proc.returncode = os.waitstatus_to_exitcode(status)
+        # ru_maxrss is in kilobytes on Linux and in bytes on macOS; it also covers the memory the
+        # child had before exec (a copy of this driver, about 10 MB), a floor for small graphs
+        peak = usage.ru_maxrss / (1024 * 1024 if sys.platform == 'darwin' else 1024)
+    else:
+        proc.wait()
+        peak = None
+    wall = time.perf_counter() - start
+    if stdin_path:
+        stdin.close()
+    if proc.returncode != 0:
+        raise RuntimeError(f"{' '.join(cmd)} exited with status {proc.returncode}")
+    return wall, peak
+
+def read_timing(path):
+    """Reads a -p timing file: load time, then one latency per query (microseconds)."""
+    load, latencies = 0.0, []
+    with open(path) as f:
+        for line in f:
+            key, value = line.split()
+            if key == 'load':
+                load = float(value)
+            else:
+                latencies.append(float(value))
+    return load, latencies
+
+def percentile(sorted_values, q):
+    """Nearest-rank percentile of an ascending list."""
+    if not sorted_values:
+        return float('nan')
+    rank = max(1, -(-len(sorted_values) * q // 100))
+    return sorted_values[int(rank) - 1]
+
+def bench_timed(cmd, queries, timing_path):
+    """Backends with -p: latencies come from the backend itself."""
+    _, peak = run_measured(cmd[:1] + ['-p', timing_path] + cmd[1:] + [queries])
+    load, latencies = read_timing(timing_path)
+    return load / 1000, sorted(latencies), peak
+
+def bench_matrix(exe, graph, queries, work):
+    """dsabm_dg_2 only reads its input interactively and prints the full matrix, so the load
+    time is a run without criteria and the latency is the mean over a run with all of them."""
+    with open(queries) as f:
+        criteria = [line.split()[0] for line in f if line.strip() and not line.startswith('#')]
+    with open(graph, 'rb') as f:
+        text = f.read()
+    runs = []
+    for count in (0, len(criteria)):
+        path = os.path.join(work, f"matrix_stdin_{count}.txt")
+        with open(path, 'wb') as f:
+            f.write(text + f"\n{count}\n".encode() + "\n".join(criteria[:count]).encode() + b"\n")
+        runs.append(run_measured([exe], path))
+    load = runs[0][0] * 1000
+    mean = (runs[1][0] - runs[0][0]) * 1e6 / max(1, len(criteria))
+    return load, [mean], max(runs[0][1] or 0, runs[1][1] or 0) or None
+
+CASE_STUDIES = ['Case Studies/CMS.txt', 'Case Studies/FMS.txt', 'Case Studies/IHG.txt', 'Case Studies/IHS.txt',
+                'Case Studies/PTY.txt', 'Case Studies/TMS.txt', 'input_file.txt']
+
+def read_bench_output(text):
+    """Per-call rows of a bench_harness.h report: (median_us, p99_us, cycles or None)."""
+    rows = []
+    for line in text.splitlines():
+        if not line or line.startswith('#'):
+            continue
+        fields = line.split()
+        rows.append((float(fields[2]), float(fields[3]), None if fields[6] == 'n/a' else float(fields[6])))
+    return rows
+
+def micro_suite(args):
+    """Runs the harness of every backend on every node of every case study."""
+    os.makedirs(args.work, exist_ok=True)
+    harness = ['-n', str(args.iterations), '-w', str(args.warmup), '-k', str(args.cpu)]
+    print(f"{'Graph':<25} | {'Backend':<10} | {'Calls':>5} | {'Median (us)':>11} | {'Max p99 (us)':>12} | {'Cycles':>9}")
+    print("-" * 88)
+    for graph in CASE_STUDIES:
+        with open(graph) as f:
+            tokens = f.read().split()
+        nodes = tokens[1:int(tokens[0]) + 1]
+        for backend in args.backends.split(','):
+            if backend == 'matrix':
+                continue
+            mode = 'pruned' if backend == 'pruned' else 'dsabm'
+            queries = os.path.join(args.work, f"micro_{mode}.txt")
+            with open(queries, 'w') as f:
+                f.writelines(f"{v} {args.tau if mode == 'pruned' else 0} {mode}\n" for v in nodes)
+            exe = {'list_time': args.list_time, 'list': args.list}.get(backend, args.integrated)
+            out = subprocess.run([exe, '-g', graph] + harness + [queries], check=True,
+                                 stdout=subprocess.PIPE, stderr=subprocess.DEVNULL, text=True).stdout
+            rows = read_bench_output(out)
+            medians = sorted(r[0] for r in rows)
+            cycles = sorted(r[2] for r in rows if r[2] is not None)
+            cycle_text = f"{cycles[len(cycles) // 2]:>9.0f}" if cycles else f"{'n/a':>9}"
+            print(f"{graph:<25} | {backend:<10} | {len(rows):>5} | {medians[len(medians) // 2]:>11.3f} | "
+                  f"{max(r[1] for r in rows):>12.3f} | {cycle_text}", flush=True)
+
+def main():
+    parser = argparse.ArgumentParser(description="Scalability benchmark of the DSABM backends")
+    parser.add_argument('--sizes', default='1000,10000,100000,1000000',
+                        help="comma-separated node counts (10^3 to 10^7)")
+    parser.add_argument('--backends', default=None,
+                        help="default matrix,list,integrated,pruned (--micro: list_time,list,integrated,pruned)")
+    parser.add_argument('--micro', action='store_true', help="harness run over the case studies")
+    parser.add_argument('--iterations', type=int, default=100, help="--micro: timed runs per call")
+    parser.add_argument('--warmup', type=int, default=10, help="--micro: discarded runs per call")
+    parser.add_argument('--cpu', type=int, default=0, help="--micro: CPU to pin to (-1: none)")
+    parser.add_argument('--queries', type=int, default=1000, help="random criteria per size")
+    parser.add_argument('--tau', type=float, default=0.15, help="threshold of the pruned queries")
+    parser.add_argument('--agents', type=int, default=0, help="agents per graph (default n / 10)")
+    parser.add_argument('--degree', type=float, default=1.26, help="edges per node")
+    parser.add_argument('--cycles', type=float, default=0.1, help="cycle density in [0, 1]")
+    parser.add_argument('--mix', default=None, help="edge type weights w1,...,w6")
+    parser.add_argument('--seed', type=int, default=1)
+    parser.add_argument('--threads', type=int, default=None, help="-t for dsabm_integrated")
+    parser.add_argument('--matrix-max', type=int, default=10000,
+                        help="largest graph given to the O(n^2) matrix backend")
+    parser.add_argument('--generator', default='./abdg_generator')
+    parser.add_argument('--matrix', default='./dsabm_dg_2')
+    parser.add_argument('--list', default='./dsabm_list_fin')
+    parser.add_argument('--list-time', default='./dsabm_list_fin_time')
+    parser.add_argument('--integrated', default='./dsabm_integrated')
+    parser.add_argument('--work', default='bench_work', help="directory for graphs and timings")
+    args = parser.parse_args()
+    if args.micro:
+        args.backends = args.backends or 'list_time,list,integrated,pruned'
+        micro_suite(args)
+        return
+    args.backends = args.backends or 'matrix,list,integrated,pruned'
+
+    os.makedirs(args.work, exist_ok=True)
+    backends = args.backends.split(',')
+    print(f"{'Nodes':>10} | {'Backend':<10} | {'Load (ms)':>10} | {'p50 (us)':>10} | {'p90 (us)':>10} | "
+          f"{'p99 (us)':>10} | {'Max (us)':>10} | {'Peak (MB)':>9}")
+    print("-" * 98)
+
+    for n in (int(float(s)) for s in args.sizes.split(',')):
+        graph = os.path.join(args.work, f"abdg_{n}.txt")
+        queries = os.path.join(args.work, f"queries_{n}.txt")
+        gen = [args.generator, '-n', str(n), '-d', str(args.degree), '-c', str(args.cycles),
+               '-s', str(args.seed), '-o', graph, '-q', queries, '-k', str(args.queries), '-t', str(args.tau)]
+        if args.agents:
+            gen += ['-g', str(args.agents)]
+        if args.mix:
+            gen += ['-m', args.mix]
+        subprocess.run(gen, check=True, stderr=subprocess.DEVNULL)
+        pruned_queries = os.path.join(args.work, f"queries_{n}_pruned.txt")
+        with open(queries) as src, open(pruned_queries, 'w') as dst:
+            for line in src:
+                dst.write(line.replace(' dsabm', ' pruned'))
+
+        timing = os.path.join(args.work, 'timing.txt')
+        threads = ['-t', str(args.threads)] if args.threads is not None else []
+        for backend in backends:
+            if backend == 'matrix':
+                if n > args.matrix_max:
+                    print(f"{n:>10} | {backend:<10} | skipped (n > --matrix-max {args.matrix_max})")
+                    continue
+                load, latencies, peak = bench_matrix(args.matrix, graph, queries, args.work)
+            elif backend == 'list':
+                load, latencies, peak = bench_timed([args.list, '-g', graph], queries, timing)
+            elif backend == 'integrated':
+                load, latencies, peak = bench_timed([args.integrated, '-g', graph] + threads, queries, timing)
+            elif backend == 'pruned':
+                load, latencies, peak = bench_timed([args.integrated, '-g', graph] + threads, pruned_queries, timing)
+            else:
+                sys.exit(f"Unknown backend {backend}")
+            # The matrix backend only has a mean latency, shown in the p50 column
+            cells = [f"{percentile(latencies, q):>10.2f}" for q in (50, 90, 99, 100)]
+            if backend == 'matrix':
+                cells[1:] = [f"{'n/a':>10}"] * 3
+            peak_text = f"{peak:>9.1f}" if peak is not None else f"{'n/a':>9}"
+            print(f"{n:>10} | {backend:<10} | {load:>10.2f} | {' | '.join(cells)} | {peak_text}", flush=True)
+
+if __name__ == "__main__":
+    main()
@@ -1,240 +1,2479 @@
 #include <iostream>
 #include <vector>
 #include <unordered_set>
+#include <unordered_map>
 #include <string>
-#include <map>
-#include <queue>
-// #include <chrono>
+#include <cstdint>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <chrono>
 #include <fstream>
-#include <conio.h>
+#include <sstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <queue>
+#include <list>
+#include <memory>
+#include <array>
+#include <cstring>
+#include <random>
+#include <cassert>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <csignal>
+#include <cerrno>
+#endif
+#include "bench_harness.h"
+#include "dsabm_slicer.h"
 
 using namespace std;
 
-class ABDG {
-    int n, e, r, a, p;
-    string *V;
-    vector<vector<pair<string, int>>> IDL;
-    fstream fs;
-
-    const map<int, double> EDGE_WEIGHTS = {
-        {6, 1.0}, {5, 0.9}, {4, 0.7}, {3, 0.5}, {2, 0.3}, {1, 0.1}
+// Thread pool spreading the indices [0, count) of a job over its workers. Every worker owns
+// a contiguous range of indices packed as (lo << 32 | hi) in one atomic word: the owner
+// takes indices from the front, and an idle worker steals the upper half of another
+// worker's range. Both sides only CAS the victim's word, so no lock is held per task.
+class WorkStealingPool {
+    // Padded to a cache line, so the words of two workers are 64 bytes apart and never share
+    // one. Padding rather than alignas(64): new only honours extended alignment from C++17.
+    struct Range {
+        atomic<uint64_t> bounds;
+        char pad[64 - sizeof(atomic<uint64_t>)];
     };
 
-    void update_r_a_p();
-    void sort_V();
-    int getNodeIndex(const string& v);
-    void initialize_incident_dependency_list();
-    void add_edges();
-    int index(const string&);
-    unordered_set<int> DSABM_Integrated(const string& s, double tau);
+    int nworkers;
+    vector<thread> threads;
+    unique_ptr<Range[]> ranges;
+    const function<void(int, size_t)>* task = nullptr;
+
+    mutex m;
+    condition_variable wake, done;
+    unsigned generation = 0;
+    int busy = 0;
+    bool stopping = false;
+
+    static uint64_t pack(uint64_t lo, uint64_t hi){ return lo << 32 | hi; }
+    bool pop(int worker, size_t& i);
+    bool steal(int worker);
+    void work(int worker);
+    void loop(int worker);
 
 public:
-    ABDG();
-    ~ABDG();
-    void display_dynamic_slice(double tau = 0.4);
+    explicit WorkStealingPool(int workers = 0);
+    ~WorkStealingPool();
+    int size() const{ return nworkers; }
+    // Runs task(worker, i) for every i in [0, count) and returns when all are done;
+    // the calling thread takes part as worker 0. Ranges hold 32-bit indices: count < 2^32.
+    void run(size_t count, const function<void(int, size_t)>& task);
 };
 
-// Constructor Definition
-ABDG::ABDG(){
-    fs.open("input_file.txt", ios::in);
-    if(!fs.is_open()){
-        cerr << "Error: Could not open input file "<<endl;
-        exit(1);
+WorkStealingPool::WorkStealingPool(int workers){
+    nworkers = workers > 0 ? workers : max(1u, thread::hardware_concurrency());
+    ranges.reset(new Range[nworkers]);
+    for(int w = 0; w < nworkers; w++)
+        ranges[w].bounds.store(0);
+    for(int w = 1; w < nworkers; w++)
+        threads.emplace_back(&WorkStealingPool::loop, this, w);
+}
+
+WorkStealingPool::~WorkStealingPool(){
+    {
+        lock_guard<mutex> lock(m);
+        stopping = true;
     }
-    fs>>n;
-    V = new string[n];
-    for(int i = 0; i < n; i++){
-        fs>>V[i];
+    wake.notify_all();
+    for(auto& t : threads)
+        t.join();
+}
+
+// Takes the next index of the worker's own range
+bool WorkStealingPool::pop(int worker, size_t& i){
+    uint64_t b = ranges[worker].bounds.load();
+    while(true){
+        uint64_t lo = b >> 32, hi = b & 0xffffffffu;
+        if(lo >= hi)
+            return false;
+        if(ranges[worker].bounds.compare_exchange_weak(b, pack(lo + 1, hi))){
+            i = lo;
+            return true;
+        }
     }
-    update_r_a_p();
-    sort_V();
-    initialize_incident_dependency_list();
 }
 
-// Destructor Definition
-ABDG::~ABDG(){
-    for(int i = 0; i < n; i++)
-        delete &IDL[i];
-    IDL.clear();
-    delete[] V;
+// Moves the upper half of some other worker's range into the (empty) range of this worker
+bool WorkStealingPool::steal(int worker){
+    for(int k = 1; k < nworkers; k++){
+        Range& victim = ranges[(worker + k) % nworkers];
+        uint64_t b = victim.bounds.load();
+        while(true){
+            uint64_t lo = b >> 32, hi = b & 0xffffffffu;
+            if(lo >= hi)
+                break;
+            uint64_t mid = lo + (hi - lo) / 2;
+            if(victim.bounds.compare_exchange_weak(b, pack(lo, mid))){
+                ranges[worker].bounds.store(pack(mid, hi));
+                return true;
+            }
+        }
+    }
+    return false;
 }
 
-// Method definition for update_r_a_p()
-void ABDG::update_r_a_p(){
-    r = a = p = 0;
-    for(int i = 0; i < n; i++){
-        if(V[i][0] == 'R')
-            r++;
-        else if(V[i][0] == 'A')
-            a++;
-        else if(V[i][0] == 'P')
-            p++;
+// Drains the worker's range, then steals until every range is empty. Indices are never
+// added during a job, so a failed pass over all victims means the rest is already claimed.
+void WorkStealingPool::work(int worker){
+    size_t i;
+    do{
+        while(pop(worker, i))
+            (*task)(worker, i);
+    } while(steal(worker));
+}
+
+void WorkStealingPool::loop(int worker){
+    unsigned seen = 0;
+    while(true){
+        {
+            unique_lock<mutex> lock(m);
+            wake.wait(lock, [&]{ return stopping || generation != seen; });
+            if(stopping)
+                return;
+            seen = generation;
+        }
+        work(worker);
+        {
+            lock_guard<mutex> lock(m);
+            if(--busy == 0)
+                done.notify_one();
+        }
     }
 }
 
-// Method definition for initialize_dependency_matrix()
-void ABDG::initialize_incident_dependency_list(){
-    vector<pair<string, int>> temp;
-    for(int i = 0; i < n; i++)
-        IDL.push_back(temp);
-    add_edges();
+void WorkStealingPool::run(size_t count, const function<void(int, size_t)>& job){
+    if(count == 0)
+        return;
+    assert(count <= 0xffffffffu);
+    task = &job;
+    for(int w = 0; w < nworkers; w++)
+        ranges[w].bounds.store(pack(count * w / nworkers, count * (w + 1) / nworkers));
+    {
+        lock_guard<mutex> lock(m);
+        busy = nworkers - 1;
+        generation++;
+    }
+    wake.notify_all();
+
+    work(0);
+    unique_lock<mutex> lock(m);
+    done.wait(lock, [&]{ return busy == 0; });
+    task = nullptr;
 }
 
-// Method definition for add_edges()
-void ABDG::add_edges(){
-    fs>>e;
-    string tail, head;
-    int edge_type;
-    for(int i = 0; i < e; i++){
-        fs>>tail>>head>>edge_type;
-        IDL[index(head)].push_back({tail, edge_type});
+// Read-only memory mapping of a whole file
+class MappedFile {
+    const char* base = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE, mapping = NULL;
+#endif
+
+public:
+    MappedFile(){}
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile(){ close(); }
+    bool open(const string& path);
+    void close();
+    const char* data() const{ return base; }
+    size_t size() const{ return length; }
+};
+
+bool MappedFile::open(const string& path){
+    close();
+#ifdef _WIN32
+    file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(file == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER file_size;
+    if(!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0){
+        close();
+        return false;
     }
+    mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    base = mapping ? (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    length = size_t(file_size.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0)
+        return false;
+    struct stat st;
+    if(fstat(fd, &st) == 0 && st.st_size > 0){
+        void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if(p != MAP_FAILED){
+            base = (const char*)p;
+            length = st.st_size;
+        }
+    }
+    ::close(fd);
+#endif
+    if(!base)
+        close();
+    return base != nullptr;
 }
 
-// Method definition for sort_V()
-void ABDG::sort_V(){
-    V[0] = "S0";
-    int index = 1;
+void MappedFile::close(){
+#ifdef _WIN32
+    if(base)
+        UnmapViewOfFile(base);
+    if(mapping)
+        CloseHandle(mapping);
+    if(file != INVALID_HANDLE_VALUE)
+        CloseHandle(file);
+    mapping = NULL;
+    file = INVALID_HANDLE_VALUE;
+#else
+    if(base)
+        munmap((void*)base, length);
+#endif
+    base = nullptr;
+    length = 0;
+}
 
-    for(int i = 1; i <= r; i++)
-        V[index++] = "R" + to_string(i);
+// Header of the binary ABDG format (version 1). The three CSR arrays follow at 8-byte
+// aligned byte offsets: IDL_off[n + 1] and IDL_tail[e] as uint32, IDL_type[e] as uint8.
+// Nodes are numbered as in the text format after sorting: S0, R1..Rr, A1..Aa, P1..Pp, J1...
+struct ABDGFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t n, e, r, a, p;
+    uint32_t reserved;
+    uint64_t off_pos, tail_pos, type_pos;
+};
+const char ABDG_MAGIC[8] = {'A', 'B', 'D', 'G', 'B', 'I', 'N', '\0'};
+const uint32_t ABDG_VERSION = 1;
 
-    for(int i = 1; i <= a; i++)
-        V[index++] = "A" + to_string(i);
+// Slice query of a batch file
+struct SliceQuery {
+    string criterion;
+    double tau;
+    string mode;
+    // Number of nodes of a topk query, read from its tau field (see read_top_k())
+    size_t k = 0;
+};
 
-    for(int i = 1; i <= p; i++)
-        V[index++] = "P" + to_string(i);
+// Modes of a slice query: backward (what the criterion depends on) and forward (what it affects)
+// slices, each unweighted or relevance-pruned at tau, chops, whose criterion is a pair
+// source:target, and the k most relevant nodes of the slice, k given in place of tau; modes with
+// odd indices read tau
+const char* const SLICE_MODES[] = {"dsabm", "pruned", "forward", "forward_pruned", "chop", "topk"};
+const char* const SLICE_MODE_LIST = "dsabm, pruned, forward, forward_pruned, chop or topk";
+const int CHOP_MODE = 4;
+const int TOPK_MODE = 5;
 
-    for(int i = 1; index < n; i++)
-        V[index++] = "J" + to_string(i);
+// Index of a mode in SLICE_MODES, -1 if it is not one
+static int mode_index(const string& mode){
+    for(int m = 0; m < int(sizeof(SLICE_MODES) / sizeof(SLICE_MODES[0])); m++)
+        if(mode == SLICE_MODES[m])
+            return m;
+    return -1;
 }
 
-// Method definition for index()
-int ABDG::index(const string& v){
-    char type = v[0];
-    int id = stoi(v.substr(1)); // Extract numeric part
+// Splits the criterion of a chop, source:target; false if it is not a pair
+static bool split_chop(const string& criterion, string& source, string& target){
+    size_t colon = criterion.find(':');
+    if(colon == string::npos || colon == 0 || colon + 1 == criterion.size())
+        return false;
+    source = criterion.substr(0, colon);
+    target = criterion.substr(colon + 1);
+    return true;
+}
 
-    switch(type){
-        case 'S':
-            return 0;
-        case 'R':
-            return id;
-        case 'A':
-            return r + id;
-        case 'P':
-            return r + a + id;
-        default:
-            return r + a + p + id;
+// Reads k of a topk query from its tau field, a whole number in [0, 2^31); false if it is not one
+static bool read_top_k(SliceQuery& q){
+    if(mode_index(q.mode) != TOPK_MODE)
+        return true;
+    if(!(q.tau >= 0 && q.tau <= INT32_MAX && q.tau == floor(q.tau)))
+        return false;
+    q.k = size_t(q.tau);
+    return true;
+}
+
+// Bounded LRU cache of slices, shared by every thread answering queries. An entry is keyed by the
+// version of the ABDG it was computed on (every load gets a new one, so a reloaded graph never
+// hits the entries of its predecessor), the criterion (and the source of a chop, -1 otherwise),
+// tau (0 for the unweighted modes), the mode
+// and the fingerprint of the phase scheme. Its cost is the size of the entry, of its slice and of
+// the list and hash nodes holding it; least recently used entries are evicted to keep the total
+// within the budget.
+class SliceCache {
+public:
+    struct Key {
+        uint64_t version, scheme;
+        int criterion, source;
+        double tau;
+        int mode;
+        bool operator==(const Key& k) const{
+            return version == k.version && scheme == k.scheme && criterion == k.criterion && source == k.source &&
+                   tau == k.tau && mode == k.mode;
+        }
+    };
+
+private:
+    struct KeyHash {
+        size_t operator()(const Key& k) const{
+            uint64_t t;
+            memcpy(&t, &k.tau, sizeof(t));
+            uint64_t h = k.version * 0x9e3779b97f4a7c15ull ^ k.scheme;
+            h = (h ^ (uint64_t(k.criterion) << 3 | k.mode)) * 0xbf58476d1ce4e5b9ull;
+            h = (h ^ uint32_t(k.source)) * 0xbf58476d1ce4e5b9ull;
+            return size_t((h ^ t) * 0x94d049bb133111ebull >> 7);
+        }
+    };
+    struct Entry {
+        Key key;
+        vector<int> slice;
+        size_t bytes;
+    };
+    // Estimated bookkeeping of an entry beyond its struct: list links and hash node
+    static const size_t NODE_BYTES = 64;
+
+    list<Entry> lru;
+    unordered_map<Key, list<Entry>::iterator, KeyHash> index;
+    size_t capacity, used = 0;
+    uint64_t hits = 0, misses = 0, evictions = 0;
+    mutable mutex m;
+
+public:
+    explicit SliceCache(size_t capacity_bytes) : capacity(capacity_bytes){}
+    bool lookup(const Key& key, vector<int>& slice);
+    void insert(const Key& key, const vector<int>& slice);
+    void invalidate(uint64_t version);
+    void report(ostream& out) const;
+};
+
+// Copies the cached slice of the key, if any, and marks it most recently used
+bool SliceCache::lookup(const Key& key, vector<int>& slice){
+    lock_guard<mutex> lock(m);
+    auto it = index.find(key);
+    if(it == index.end()){
+        misses++;
+        return false;
     }
+    hits++;
+    lru.splice(lru.begin(), lru, it->second);
+    slice.assign(it->second->slice.begin(), it->second->slice.end());
+    return true;
 }
 
-int ABDG::getNodeIndex(const string& v) {
-    if (v == "S0") return 0;
-    char type = v[0];
-    int id = stoi(v.substr(1));
+void SliceCache::insert(const Key& key, const vector<int>& slice){
+    size_t bytes = sizeof(Entry) + NODE_BYTES + slice.size() * sizeof(int);
+    if(bytes > capacity)
+        return;
+    lock_guard<mutex> lock(m);
+    // Two threads may miss on the same key; the first answer stays
+    if(index.count(key))
+        return;
+    while(used + bytes > capacity){
+        used -= lru.back().bytes;
+        index.erase(lru.back().key);
+        lru.pop_back();
+        evictions++;
+    }
+    lru.push_front(Entry{key, slice, bytes});
+    index[key] = lru.begin();
+    used += bytes;
+}
 
-    switch(type) {
-        case 'R': return id;
-        case 'A': return r + id;
-        case 'P': return r + a + id;
-        default:  return r + a + p + id; // Join nodes (J)
+// Drops the entries computed on the given version of an ABDG
+void SliceCache::invalidate(uint64_t version){
+    lock_guard<mutex> lock(m);
+    for(auto it = lru.begin(); it != lru.end();){
+        if(it->key.version != version){
+            ++it;
+            continue;
+        }
+        used -= it->bytes;
+        index.erase(it->key);
+        it = lru.erase(it);
     }
 }
 
-unordered_set<int> ABDG::DSABM_Integrated(const string& s, double tau) {
-    unordered_set<int> tempDS;
-    map<int, double> node_relevance;
-    queue<pair<int, double>> M1, M2, M3;
+void SliceCache::report(ostream& out) const{
+    lock_guard<mutex> lock(m);
+    uint64_t lookups = hits + misses;
+    out << "cache: " << hits << " hits, " << misses << " misses (" << fixed << setprecision(1)
+        << (lookups ? 100.0 * hits / lookups : 0.0) << "% hit rate), " << lru.size() << " entries, " << used
+        << " of " << capacity << " bytes, " << evictions << " evictions" << endl;
+    out.unsetf(ios::floatfield);
+    out << setprecision(6);
+}
 
-    int start_node = getNodeIndex(s);
-    M1.push({start_node, 1.0});
-    node_relevance[start_node] = 1.0;
+// Version of every ABDG loaded by the process
+static atomic<uint64_t> graph_versions(0);
+
+// Internal numbering of the nodes of a loaded ABDG (see ABDG::reorder()): the canonical one of
+// the files (S0, R*, A*, P*, J*), reverse Cuthill-McKee, or grouped by agent
+enum NodeOrder { TYPE_ORDER, RCM_ORDER, AGENT_ORDER };
+const char* const NODE_ORDERS[] = {"type", "rcm", "agent"};
+
+class ABDG : public SliceCSR {
+    friend class DynamicSlices;
+    friend class GraphRegistry;
+    friend class SliceServer;
+
+    // Version of this load of the graph, and the cache of its slices (none by default)
+    uint64_t version;
+    SliceCache* cache = nullptr;
+    // The incident-dependency list lives in csr_* when parsed from text, or in the mapped binary
+    // file (see SliceCSR)
+    MappedFile mapped;
+
+    // Chunks of a mapped text ABDG for the parser threads: chunk c spans [begin[c], begin[c + 1])
+    // and starts at whitespace, so no token straddles two chunks; first_token[c] is the global
+    // index of its first token
+    struct TextChunks {
+        const char* text;
+        vector<size_t> begin;
+        vector<uint64_t> first_token;
+    };
+
+    bool load(const string& file, WorkStealingPool* pool, NodeOrder order, string& error);
+    bool load_text(const string& file, WorkStealingPool* pool, string& error);
+    void split_text(const MappedFile& text, WorkStealingPool& pool, TextChunks& chunks) const;
+    bool update_r_a_p(const TextChunks& chunks, WorkStealingPool& pool, string& error);
+    bool load_binary(const string& file, string& error);
+    int getNodeIndex(const string& v) const;
+    bool add_edges(const TextChunks& chunks, WorkStealingPool& pool, string& error);
+    void build_outgoing(WorkStealingPool* pool);
+    vector<int> rcm_sequence() const;
+    vector<int> agent_sequence() const;
+    void reorder(NodeOrder order, WorkStealingPool* pool);
+    bool valid_node(const string& v) const;
+    bool valid_criterion(const SliceQuery& q) const;
+    const vector<int>& DSABM(const string& s, SliceScratch& ws) const;
+    const vector<int>& DSABM_Integrated(const string& s, double tau, SliceScratch& ws) const;
+    const vector<int>& DSABM_Top(const string& s, size_t k, SliceScratch& ws) const;
+    const vector<int>& DSABM_Forward(const string& s, SliceScratch& ws) const;
+    const vector<int>& DSABM_Forward_Integrated(const string& s, double tau, SliceScratch& ws) const;
+    const vector<int>& Chop(const string& criterion, SliceScratch& ws) const;
+    const vector<int>& compute(const SliceQuery& q, SliceScratch& ws) const;
+    const vector<pair<double, int>>& relevance_profile(const string& s, SliceScratch& ws) const;
+    static size_t profile_slice_size(const vector<pair<double, int>>& profile, double tau);
+    void calibrate(const string& s, SliceScratch& ws, ostream& out) const;
+    static vector<SliceQuery> read_queries(const string& query_file, const ABDG* G);
+    const vector<int>& slice(const SliceQuery& q, SliceScratch& ws) const;
+    string answer_query(const SliceQuery& q, SliceScratch& ws) const;
+
+public:
+    ABDG(const string& file = "input_file.txt", WorkStealingPool* pool = nullptr, NodeOrder order = TYPE_ORDER,
+         string* error = nullptr);
+    ABDG(const ABDG&) = delete;
+    ABDG& operator=(const ABDG&) = delete;
+    string node_name(int i) const;
+    void save_binary(const string& file) const;
+    uint64_t graph_version() const{ return version; }
+    void use_cache(SliceCache* c){ cache = c; }
+    void display_dynamic_slice(double tau = 0.4);
+    void run_batch(const string& query_file, ostream* timing = nullptr) const;
+    void run_parallel(const string& query_file, WorkStealingPool& pool, ostream* timing = nullptr) const;
+    void run_bench(const string& query_file, const BenchConfig& config) const;
+    void calibrate(const vector<string>& criteria) const;
+    static void run_sensitivity(const string& spec_file, int samples, uint64_t seed, WorkStealingPool& pool,
+                                NodeOrder order = TYPE_ORDER);
+};
+
+// Constructor Definition: a file that cannot be loaded is an error, on standard error before
+// exiting, or in *error (the ABDG is then empty and must not be used) when it is given
+ABDG::ABDG(const string& file, WorkStealingPool* pool, NodeOrder order, string* error){
+    string message;
+    if(load(file, pool, order, message))
+        return;
+    if(error){
+        *error = message;
+        return;
+    }
+    cerr << "Error: " << message << endl;
+    exit(1);
+}
+
+// Binary ABDGs are mapped as they are, text ones are parsed on the threads of the pool (a
+// private pool over all cores if none is given); any order but TYPE_ORDER renumbers the nodes
+// afterwards. False, with the reason, if the file cannot be loaded.
+bool ABDG::load(const string& file, WorkStealingPool* pool, NodeOrder order, string& error){
+    if(!load_binary(file, error) && (!error.empty() || !load_text(file, pool, error)))
+        return false;
+    build_outgoing(pool);
+    if(order != TYPE_ORDER)
+        reorder(order, pool);
+    version = ++graph_versions;
+    return true;
+}
+
+static inline bool is_blank(char c){
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\f' || c == '\v';
+}
+
+// Calls f(t, begin, end) for the tokens of [from, to), numbered from first; [from, to) must
+// start at whitespace or at the beginning of the text. Stops early when f returns false.
+template <class F>
+static void for_each_token(const char* from, const char* to, uint64_t first, F f){
+    const char* c = from;
+    for(uint64_t t = first;; t++){
+        while(c < to && is_blank(*c))
+            c++;
+        if(c == to)
+            return;
+        const char* b = c;
+        while(c < to && !is_blank(*c))
+            c++;
+        if(!f(t, b, c))
+            return;
+    }
+}
 
-    // Phase 1: Traversal along direct data transactions and procedures
-    while (!M1.empty()) {
-        pair<int, double> current = M1.front();
-        M1.pop();
+// Parses the unsigned number [b, e); false if it is not one
+static bool parse_number(const char* b, const char* e, uint64_t& x){
+    x = 0;
+    if(b == e || e - b > 19)
+        return false;
+    for(; b < e; b++){
+        if(*b < '0' || *b > '9')
+            return false;
+        x = x * 10 + (*b - '0');
+    }
+    return true;
+}
 
-        for (auto& edge : IDL[current.first]) {
-            int u = getNodeIndex(edge.first);
-            double new_w = current.second * EDGE_WEIGHTS.at(edge.second);
+// Loads a text ABDG without iostreams or per-token strings: the file is mapped, split into
+// chunks, and each pass below runs over the chunks in parallel
+bool ABDG::load_text(const string& file, WorkStealingPool* pool, string& error){
+    MappedFile text;
+    if(!text.open(file)){
+        error = "Could not open input file " + file;
+        return false;
+    }
+    unique_ptr<WorkStealingPool> own;
+    if(!pool){
+        own.reset(new WorkStealingPool(text.size() < (1 << 20) ? 1 : 0));
+        pool = own.get();
+    }
+    TextChunks chunks;
+    split_text(text, *pool, chunks);
+    return update_r_a_p(chunks, *pool, error) && add_edges(chunks, *pool, error);
+}
 
-            if (new_w >= tau && new_w > node_relevance[u]) {
-                node_relevance[u] = new_w;
-                tempDS.insert(u);
+// Method definition for split_text(): chunk boundaries and the token count of every chunk
+void ABDG::split_text(const MappedFile& text, WorkStealingPool& pool, TextChunks& chunks) const{
+    const char* data = text.data();
+    size_t size = text.size();
+    size_t count = max<size_t>(1, min<size_t>(pool.size() * 8, size / 65536));
+    chunks.text = data;
+    chunks.begin.assign(count + 1, size);
+    chunks.begin[0] = 0;
+    for(size_t c = 1; c < count; c++){
+        size_t at = max(size * c / count, chunks.begin[c - 1]);
+        while(at < size && !is_blank(data[at]))
+            at++;
+        chunks.begin[c] = at;
+    }
+
+    chunks.first_token.assign(count + 1, 0);
+    pool.run(count, [&](int, size_t c){
+        uint64_t tokens = 0;
+        for_each_token(data + chunks.begin[c], data + chunks.begin[c + 1], 0, [&](uint64_t, const char*, const char*){
+            tokens++;
+            return true;
+        });
+        chunks.first_token[c + 1] = tokens;
+    });
+    for(size_t c = 0; c < count; c++)
+        chunks.first_token[c + 1] += chunks.first_token[c];
+}
+
+// Method definition for update_r_a_p(): reads n (token 0), counts the node types of the
+// vertex list (tokens 1..n) and reads e (token n + 1)
+bool ABDG::update_r_a_p(const TextChunks& chunks, WorkStealingPool& pool, string& error){
+    size_t count = chunks.begin.size() - 1;
+    uint64_t value = 0;
+    for_each_token(chunks.text, chunks.text + chunks.begin[count], 0, [&](uint64_t, const char* b, const char* e){
+        if(!parse_number(b, e, value))
+            value = 0;
+        return false;
+    });
+    if(value == 0 || value >= UINT32_MAX){
+        error = "Invalid number of vertices in input file";
+        return false;
+    }
+    n = value;
+    if(chunks.first_token[count] < uint64_t(n) + 2){
+        error = "Input file ends inside the vertex list";
+        return false;
+    }
 
-                if (edge.second >= 3) M1.push({u, new_w}); // Types 6, 5, 4, 3
-                else if (edge.second == 2) M2.push({u, new_w});
-                else M3.push({u, new_w});
+    vector<array<int, 3>> counts(count, array<int, 3>{{0, 0, 0}});
+    uint64_t edges = UINT64_MAX;
+    pool.run(count, [&](int, size_t c){
+        if(chunks.first_token[c] > uint64_t(n) + 1)
+            return;
+        for_each_token(chunks.text + chunks.begin[c], chunks.text + chunks.begin[c + 1], chunks.first_token[c],
+                       [&](uint64_t t, const char* b, const char* e){
+            if(t >= 1 && t <= uint64_t(n)){
+                if(*b == 'R')
+                    counts[c][0]++;
+                else if(*b == 'A')
+                    counts[c][1]++;
+                else if(*b == 'P')
+                    counts[c][2]++;
+            }
+            else if(t == uint64_t(n) + 1 && !parse_number(b, e, edges))
+                edges = UINT64_MAX;
+            return t <= uint64_t(n);
+        });
+    });
+    r = a = p = 0;
+    for(auto& c : counts){
+        r += c[0];
+        a += c[1];
+        p += c[2];
+    }
+    if(edges >= UINT32_MAX){
+        error = "Invalid number of edges in input file";
+        return false;
+    }
+    e = edges;
+    return true;
+}
+
+// Maps a binary ABDG in place, validating it once; false if it is not one (reason in error)
+bool ABDG::load_binary(const string& file, string& error){
+    if(!mapped.open(file) || mapped.size() < sizeof(ABDGFileHeader) || memcmp(mapped.data(), ABDG_MAGIC, 8) != 0){
+        mapped.close();
+        return false;
+    }
+    ABDGFileHeader h;
+    memcpy(&h, mapped.data(), sizeof(h));
+    const char* invalid = nullptr;
+    if(h.version != ABDG_VERSION)
+        invalid = "unsupported binary ABDG version";
+    else if(h.n == 0 || h.n > uint32_t(INT32_MAX) || h.e > uint32_t(INT32_MAX) || uint64_t(h.r) + h.a + h.p >= h.n)
+        invalid = "inconsistent node counts in binary ABDG";
+    else if(h.off_pos % 8 || h.tail_pos % 8 || h.off_pos > mapped.size() || h.tail_pos > mapped.size() ||
+            h.type_pos > mapped.size() || 4 * (uint64_t(h.n) + 1) > mapped.size() - h.off_pos ||
+            4 * uint64_t(h.e) > mapped.size() - h.tail_pos || h.e > mapped.size() - h.type_pos)
+        invalid = "truncated binary ABDG";
+    if(!invalid){
+        IDL_off = (const uint32_t*)(mapped.data() + h.off_pos);
+        IDL_tail = (const uint32_t*)(mapped.data() + h.tail_pos);
+        IDL_type = (const uint8_t*)(mapped.data() + h.type_pos);
+        // Offsets ascend from 0 to e, tails are nodes and types are 1..6
+        bool corrupt = IDL_off[0] != 0 || IDL_off[h.n] != h.e;
+        for(uint32_t v = 0; v < h.n; v++)
+            corrupt |= IDL_off[v] > IDL_off[v + 1];
+        for(uint32_t k = 0; k < h.e; k++)
+            corrupt |= IDL_tail[k] >= h.n || IDL_type[k] < 1 || IDL_type[k] >= EDGE_TYPES;
+        if(corrupt)
+            invalid = "corrupt incident-dependency list in binary ABDG";
+    }
+    if(invalid){
+        mapped.close();
+        error = string(invalid) + " " + file;
+        return false;
+    }
+    n = h.n;
+    e = h.e;
+    r = h.r;
+    a = h.a;
+    p = h.p;
+    return true;
+}
+
+// Converter to the binary format: header, then the CSR arrays at 8-byte aligned offsets. A
+// renumbered ABDG is written back in the canonical order.
+void ABDG::save_binary(const string& file) const{
+    ofstream out(file, ios::binary);
+    if(!out.is_open()){
+        cerr << "Error: Could not write binary ABDG "<<file<<endl;
+        exit(1);
+    }
+    ABDGFileHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, ABDG_MAGIC, 8);
+    h.version = ABDG_VERSION;
+    h.n = n;
+    h.e = e;
+    h.r = r;
+    h.a = a;
+    h.p = p;
+    auto align = [](uint64_t pos){ return (pos + 7) & ~uint64_t(7); };
+    h.off_pos = align(sizeof(h));
+    h.tail_pos = align(h.off_pos + 4 * (uint64_t(n) + 1));
+    h.type_pos = align(h.tail_pos + 4 * uint64_t(e));
+
+    const uint32_t *off = IDL_off, *tail = IDL_tail;
+    const uint8_t* type = IDL_type;
+    vector<uint32_t> canonical_off, canonical_tail;
+    vector<uint8_t> canonical_type;
+    if(!canonical.empty()){
+        canonical_off.assign(n + 1, 0);
+        canonical_tail.reserve(e);
+        canonical_type.reserve(e);
+        for(int c = 0; c < n; c++){
+            int v = position[c];
+            canonical_off[c + 1] = canonical_off[c] + IDL_off[v + 1] - IDL_off[v];
+            for(uint32_t k = IDL_off[v]; k < IDL_off[v + 1]; k++){
+                canonical_tail.push_back(canonical[IDL_tail[k]]);
+                canonical_type.push_back(IDL_type[k]);
             }
         }
+        off = canonical_off.data();
+        tail = canonical_tail.data();
+        type = canonical_type.data();
     }
 
-    // Phase 2: Propagation along inter-agent message dependency
-    while (!M2.empty()) {
-        pair<int, double> current = M2.front();
-        M2.pop();
+    const char zeros[8] = {0};
+    out.write((const char*)&h, sizeof(h));
+    out.write(zeros, h.off_pos - sizeof(h));
+    out.write((const char*)off, 4 * (uint64_t(n) + 1));
+    out.write(zeros, h.tail_pos - (h.off_pos + 4 * (uint64_t(n) + 1)));
+    out.write((const char*)tail, 4 * uint64_t(e));
+    out.write(zeros, h.type_pos - (h.tail_pos + 4 * uint64_t(e)));
+    out.write((const char*)type, e);
+    if(!out){
+        cerr << "Error: Could not write binary ABDG "<<file<<endl;
+        exit(1);
+    }
+}
 
-        for (auto& edge : IDL[current.first]) {
-            int u = getNodeIndex(edge.first);
-            double new_w = current.second * EDGE_WEIGHTS.at(edge.second);
+// Method definition for add_edges(): parallel parse and counting sort into the CSR, in input order
+bool ABDG::add_edges(const TextChunks& chunks, WorkStealingPool& pool, string& error){
+    size_t count = chunks.begin.size() - 1;
+    uint64_t first_edge_token = uint64_t(n) + 2, end_token = first_edge_token + 3 * uint64_t(e);
+    if(chunks.first_token[count] < end_token){
+        error = "Input file ends inside the edge list";
+        return false;
+    }
 
-            if (new_w >= tau && new_w > node_relevance[u]) {
-                node_relevance[u] = new_w;
-                tempDS.insert(u);
+    vector<uint32_t> heads(e), tails(e);
+    vector<uint8_t> types(e);
+    unique_ptr<atomic<uint32_t>[]> cursor(new atomic<uint32_t>[n]);
+    for(int i = 0; i < n; i++)
+        cursor[i].store(0, memory_order_relaxed);
+    atomic<bool> bad(false);
+    pool.run(count, [&](int, size_t c){
+        if(chunks.first_token[c + 1] <= first_edge_token || chunks.first_token[c] >= end_token)
+            return;
+        for_each_token(chunks.text + chunks.begin[c], chunks.text + chunks.begin[c + 1], chunks.first_token[c],
+                       [&](uint64_t t, const char* b, const char* end){
+            if(t < first_edge_token)
+                return true;
+            if(t >= end_token)
+                return false;
+            uint64_t edge = (t - first_edge_token) / 3, type;
+            switch((t - first_edge_token) % 3){
+                case 0: {
+                    int v = index(b, end);
+                    if(v < 0)
+                        bad = true;
+                    else
+                        tails[edge] = v;
+                    break;
+                }
+                case 1: {
+                    int v = index(b, end);
+                    if(v < 0)
+                        bad = true;
+                    else{
+                        heads[edge] = v;
+                        cursor[v].fetch_add(1, memory_order_relaxed);
+                    }
+                    break;
+                }
+                default:
+                    if(!parse_number(b, end, type) || type < 1 || type > 6)
+                        bad = true;
+                    else
+                        types[edge] = type;
+            }
+            return true;
+        });
+    });
+    if(bad){
+        error = "Unknown node or edge type in the edge list of the input file";
+        return false;
+    }
 
-                if (edge.second == 6 || edge.second == 5) M2.push({u, new_w});
-                else if (edge.second == 4 || edge.second == 1) M3.push({u, new_w});
+    // Prefix sums of the in-degrees; the cursors then start at the first edge of each head
+    csr_off.assign(n + 1, 0);
+    for(int i = 0; i < n; i++){
+        csr_off[i + 1] = csr_off[i] + cursor[i].load(memory_order_relaxed);
+        cursor[i].store(csr_off[i], memory_order_relaxed);
+    }
+
+    vector<uint32_t> order(e);
+    size_t parts = pool.size() * 8;
+    pool.run(parts, [&](int, size_t part){
+        for(size_t i = e * part / parts; i < e * (part + 1) / parts; i++)
+            order[cursor[heads[i]].fetch_add(1, memory_order_relaxed)] = i;
+    });
+    csr_tail.resize(e);
+    csr_type.resize(e);
+    pool.run(parts, [&](int, size_t part){
+        for(size_t v = n * part / parts; v < n * (part + 1) / parts; v++){
+            sort(order.begin() + csr_off[v], order.begin() + csr_off[v + 1]);
+            for(uint32_t k = csr_off[v]; k < csr_off[v + 1]; k++){
+                csr_tail[k] = tails[order[k]];
+                csr_type[k] = types[order[k]];
             }
         }
-    }
+    });
+    IDL_off = csr_off.data();
+    IDL_tail = csr_tail.data();
+    IDL_type = csr_type.data();
+    return true;
+}
 
-    // Phase 3: Propagation along control dependency
-    while (!M3.empty()) {
-        pair<int, double> current = M3.front();
-        M3.pop();
+// Method definition for build_outgoing(): the outgoing list of the IDL (see
+// SliceCSR::build_outgoing()), on a private pool over all cores if none is given
+void ABDG::build_outgoing(WorkStealingPool* pool){
+    unique_ptr<WorkStealingPool> own;
+    if(!pool){
+        own.reset(new WorkStealingPool(e < (1 << 20) ? 1 : 0));
+        pool = own.get();
+    }
+    SliceCSR::build_outgoing(*pool);
+}
 
-        for (auto& edge : IDL[current.first]) {
-            int u = getNodeIndex(edge.first);
-            double new_w = current.second * EDGE_WEIGHTS.at(edge.second);
+// Method definition for rcm_sequence(): reverse Cuthill-McKee order of the undirected graph
+vector<int> ABDG::rcm_sequence() const{
+    vector<uint32_t> degree(n);
+    vector<int> by_degree(n);
+    for(int v = 0; v < n; v++){
+        degree[v] = IDL_off[v + 1] - IDL_off[v] + ODL_off[v + 1] - ODL_off[v];
+        by_degree[v] = v;
+    }
+    auto lighter = [&](int u, int v){ return degree[u] < degree[v]; };
+    stable_sort(by_degree.begin(), by_degree.end(), lighter);
 
-            if (new_w >= tau && new_w > node_relevance[u]) {
-                if (edge.second == 6 || edge.second == 5 || edge.second == 3) {
-                    node_relevance[u] = new_w;
-                    tempDS.insert(u);
-                    M3.push({u, new_w});
+    vector<int> order;
+    order.reserve(n);
+    vector<char> placed(n, 0);
+    size_t head = 0;
+    for(int start : by_degree){
+        if(placed[start])
+            continue;
+        placed[start] = 1;
+        order.push_back(start);
+        for(; head < order.size(); head++){
+            int v = order[head];
+            size_t first = order.size();
+            for(uint32_t k = IDL_off[v]; k < IDL_off[v + 1]; k++)
+                if(!placed[IDL_tail[k]]){
+                    placed[IDL_tail[k]] = 1;
+                    order.push_back(IDL_tail[k]);
                 }
+            for(uint32_t k = ODL_off[v]; k < ODL_off[v + 1]; k++)
+                if(!placed[ODL_head[k]]){
+                    placed[ODL_head[k]] = 1;
+                    order.push_back(ODL_head[k]);
+                }
+            stable_sort(order.begin() + first, order.end(), lighter);
+        }
+    }
+    reverse(order.begin(), order.end());
+    return order;
+}
+
+// Method definition for agent_sequence(): the nodes grouped by agent, an agent being a block
+// joined by intra-agent edges (all but types 2 and 5; S0 joins none)
+vector<int> ABDG::agent_sequence() const{
+    vector<int> parent(n);
+    for(int v = 0; v < n; v++)
+        parent[v] = v;
+    auto find_root = [&](int v){
+        while(parent[v] != v)
+            v = parent[v] = parent[parent[v]];
+        return v;
+    };
+    for(int v = 0; v < n; v++)
+        for(uint32_t k = IDL_off[v]; k < IDL_off[v + 1]; k++)
+            if(IDL_type[k] != 2 && IDL_type[k] != 5 && v != 0 && IDL_tail[k] != 0){
+                int x = find_root(v), y = find_root(IDL_tail[k]);
+                if(x != y)
+                    parent[max(x, y)] = min(x, y);
             }
+
+    // The root of a block is its first node: counting sort of the nodes on their root
+    vector<int> start(n + 1, 0), order(n);
+    for(int v = 0; v < n; v++){
+        parent[v] = find_root(v);
+        start[parent[v] + 1]++;
+    }
+    for(int v = 0; v < n; v++)
+        start[v + 1] += start[v];
+    for(int v = 0; v < n; v++)
+        order[start[parent[v]]++] = v;
+    return order;
+}
+
+// Method definition for reorder(): renumbers the nodes in the given order for locality
+void ABDG::reorder(NodeOrder order, WorkStealingPool* pool){
+    canonical = order == RCM_ORDER ? rcm_sequence() : agent_sequence();
+    position.resize(n);
+    for(int v = 0; v < n; v++)
+        position[canonical[v]] = v;
+
+    vector<uint32_t> off(n + 1, 0), tail(e);
+    vector<uint8_t> type(e);
+    for(int v = 0; v < n; v++){
+        int c = canonical[v];
+        off[v + 1] = off[v] + IDL_off[c + 1] - IDL_off[c];
+        for(uint32_t k = IDL_off[c], j = off[v]; k < IDL_off[c + 1]; k++, j++){
+            tail[j] = position[IDL_tail[k]];
+            type[j] = IDL_type[k];
         }
     }
+    csr_off.swap(off);
+    csr_tail.swap(tail);
+    csr_type.swap(type);
+    IDL_off = csr_off.data();
+    IDL_tail = csr_tail.data();
+    IDL_type = csr_type.data();
+    mapped.close();
+    build_outgoing(pool);
+}
 
-    tempDS.erase(start_node);
-    return tempDS;
+// Method definition for node_name(): inverse of index(), nodes sorted as S0, R*, A*, P*, J*
+string ABDG::node_name(int i) const{
+    return SliceNumbering::node_name(canonical_id(i));
 }
 
-void ABDG::display_dynamic_slice(double tau) {
+// Internal id of node v, -1 if it is not a node
+int ABDG::getNodeIndex(const string& v) const{
+    int i = index(v);
+    return i < 0 ? -1 : internal_id(i);
+}
+
+// Criteria come from clients: index() parses them without a throwing conversion, so a name
+// of any length is answered as unknown
+bool ABDG::valid_node(const string& v) const{
+    return index(v) >= 0;
+}
+
+// Criterion of a query: a node, or a pair of nodes for a chop
+bool ABDG::valid_criterion(const SliceQuery& q) const{
+    string source, target;
+    if(mode_index(q.mode) != CHOP_MODE)
+        return valid_node(q.criterion);
+    return split_chop(q.criterion, source, target) && valid_node(source) && valid_node(target);
+}
+
+const vector<int>& ABDG::DSABM(const string& s, SliceScratch& ws) const{
+    return DSABM_kernel<DSABMScheme>(getNodeIndex(s), ws);
+}
+
+const vector<int>& ABDG::DSABM_Integrated(const string& s, double tau, SliceScratch& ws) const{
+    int start_node = getNodeIndex(s);
+    propagate<DSABMScheme>(start_node, tau, ws);
+
+    // reached[0] is the criterion itself
+    ws.slice.assign(ws.reached.begin() + 1, ws.reached.end());
+    return ws.slice;
+}
+
+const vector<int>& ABDG::DSABM_Top(const string& s, size_t k, SliceScratch& ws) const{
+    return top_k<DSABMScheme>(getNodeIndex(s), k, ws);
+}
+
+const vector<int>& ABDG::DSABM_Forward(const string& s, SliceScratch& ws) const{
+    return forward_kernel<DSABMScheme>(getNodeIndex(s), ws);
+}
+
+const vector<int>& ABDG::DSABM_Forward_Integrated(const string& s, double tau, SliceScratch& ws) const{
+    propagate_forward<DSABMScheme>(getNodeIndex(s), tau, ws);
+    // reached[0] is the criterion itself
+    ws.slice.assign(ws.reached.begin() + 1, ws.reached.end());
+    return ws.slice;
+}
+
+const vector<int>& ABDG::Chop(const string& criterion, SliceScratch& ws) const{
+    string source, target;
+    split_chop(criterion, source, target);
+    return chop_kernel<DSABMScheme>(getNodeIndex(source), getNodeIndex(target), ws);
+}
+
+// Single traversal computing the maximal relevance of every node reachable from s.
+// The slice for any tau is then the prefix of the profile with relevance >= tau.
+const vector<pair<double, int>>& ABDG::relevance_profile(const string& s, SliceScratch& ws) const{
+    return profile_kernel<DSABMScheme>(getNodeIndex(s), ws);
+}
+
+// Number of nodes of a profile with relevance >= tau
+size_t ABDG::profile_slice_size(const vector<pair<double, int>>& profile, double tau){
+    return partition_point(profile.begin(), profile.end(),
+                           [tau](const pair<double, int>& entry){ return entry.first >= tau; }) - profile.begin();
+}
+
+// Slice size vs tau, compression and knee-point tau_opt from a single relevance profile
+// (same thresholds and knee detection as pruning_calibration.py)
+void ABDG::calibrate(const string& s, SliceScratch& ws, ostream& out) const{
+    const vector<pair<double, int>>& profile = relevance_profile(s, ws);
+
+    const int steps = 21;
+    double thresholds[steps], sizes[steps];
+    size_t full_size = max<size_t>(profile_slice_size(profile, 0.0), 1);
+
+    out << "\nCalibration for Criterion: " << s << "\n";
+    out << left << setw(15) << "Threshold (Tau)" << " | " << setw(10) << "Slice Size" << " | " << "Compression %" << "\n";
+    out << string(45, '-') << "\n";
+    for(int i = 0; i < steps; i++){
+        thresholds[i] = double(i) / (steps - 1);
+        size_t size = profile_slice_size(profile, thresholds[i]);
+        sizes[i] = size;
+        out << fixed << setprecision(2) << setw(15) << thresholds[i] << " | " << setw(10) << size << " | "
+             << setprecision(1) << (1.0 - double(size) / full_size) * 100 << "%\n";
+    }
+
+    // Knee point: threshold farthest from the chord of the normalized curve
+    double tau_opt = 0.0;
+    double y_min = *min_element(sizes, sizes + steps), y_max = *max_element(sizes, sizes + steps);
+    if(y_max > y_min){
+        double x1 = 0.0, y1 = (sizes[0] - y_min) / (y_max - y_min);
+        double x2 = 1.0, y2 = (sizes[steps - 1] - y_min) / (y_max - y_min);
+        double best = -1.0;
+        for(int i = 0; i < steps; i++){
+            double x3 = thresholds[i], y3 = (sizes[i] - y_min) / (y_max - y_min);
+            double dist = fabs((x2 - x1) * (y1 - y3) - (y2 - y1) * (x1 - x3)) / hypot(x2 - x1, y2 - y1);
+            if(dist > best){
+                best = dist;
+                tau_opt = thresholds[i];
+            }
+        }
+    }
+    out << "\nOptimal Threshold (Tau_opt) identified at: " << setprecision(2) << tau_opt << "\n";
+
+    // Exact curve: the slice size only changes at the relevance values in the profile
+    out << "Slice size for tau in (next, relevance]:";
+    for(size_t i = 0; i < profile.size(); i++)
+        if(i + 1 == profile.size() || profile[i + 1].first != profile[i].first)
+            out << " " << setprecision(4) << profile[i].first << ":" << i + 1;
+    out << "\n";
+    out.unsetf(ios::floatfield);
+    out << right << setprecision(6);
+}
+
+// Calibrates the given criteria (every node of the ABDG if none are given), one traversal each
+void ABDG::calibrate(const vector<string>& criteria) const{
+    SliceScratch ws = make_scratch();
+    for(const string& s : criteria){
+        if(valid_node(s))
+            calibrate(s, ws, cout);
+        else
+            cerr << "Error: Unknown slice criterion " << s << endl;
+    }
+    if(criteria.empty())
+        for(int i = 0; i < n; i++)
+            calibrate(node_name(internal_id(i)), ws, cout);
+    cout.flush();
+}
+
+void ABDG::display_dynamic_slice(double tau){
     string s;
     cout << "\nThreshold (tau): " << tau << "\nEnter the slice criterion (node): ";
     cin >> s;
 
     // auto start = chrono::high_resolution_clock::now();
-    unordered_set<int> result = DSABM_Integrated(s, tau);
+    SliceScratch ws = make_scratch();
+    const vector<int>& result = DSABM_Integrated(s, tau, ws);
     // auto stop = chrono::high_resolution_clock::now();
 
     cout << "Dynamic Slice Set: ";
-    for(int idx : result) cout << V[idx] << " ";
+    for(int idx : result)
+        cout << node_name(idx) << " ";
     
     // auto duration = chrono::duration_cast<chrono::microseconds>(stop - start);
     // cout << "\nSlicing Time: " << duration.count() << " microseconds" << endl;
 }
 
-int main() {
-    ABDG G;
+// Queries whose criterion is not a node of G are left out (with an error); without G, only the
+// syntax and the mode of the lines are checked
+vector<SliceQuery> ABDG::read_queries(const string& query_file, const ABDG* G){
+    ifstream qs(query_file);
+    if(!qs.is_open()){
+        cerr << "Error: Could not open query file " << query_file << endl;
+        exit(1);
+    }
+
+    vector<SliceQuery> queries;
+    string line;
+    SliceQuery q;
+    while(getline(qs, line)){
+        istringstream ls(line);
+        if(!(ls >> q.criterion) || q.criterion[0] == '#')
+            continue;
+        if(!(ls >> q.tau >> q.mode)){
+            cerr << "Error: Malformed query: " << line << endl;
+            continue;
+        }
+        if(mode_index(q.mode) < 0){
+            cerr << "Error: Unsupported mode " << q.mode << " (expected " << SLICE_MODE_LIST << ")" << endl;
+            continue;
+        }
+        if(!read_top_k(q)){
+            cerr << "Error: Expected a whole number k in [0, 2^31) for topk: " << line << endl;
+            continue;
+        }
+        if(G && !G->valid_criterion(q)){
+            cerr << "Error: Unknown slice criterion " << q.criterion << endl;
+            continue;
+        }
+        queries.push_back(q);
+    }
+    return queries;
+}
+
+const vector<int>& ABDG::compute(const SliceQuery& q, SliceScratch& ws) const{
+    switch(mode_index(q.mode)){
+        case 0: return DSABM(q.criterion, ws);
+        case 1: return DSABM_Integrated(q.criterion, q.tau, ws);
+        case 2: return DSABM_Forward(q.criterion, ws);
+        case 3: return DSABM_Forward_Integrated(q.criterion, q.tau, ws);
+        case CHOP_MODE: return Chop(q.criterion, ws);
+        default: return DSABM_Top(q.criterion, q.k, ws);
+    }
+}
+
+// Answers from the cache when one is attached and holds the query
+const vector<int>& ABDG::slice(const SliceQuery& q, SliceScratch& ws) const{
+    if(!cache)
+        return compute(q, ws);
+
+    static const uint64_t scheme = scheme_fingerprint<DSABMScheme>();
+    int mode = mode_index(q.mode);
+    string source, target = q.criterion;
+    if(mode == CHOP_MODE)
+        split_chop(q.criterion, source, target);
+    SliceCache::Key key = {version, scheme, getNodeIndex(target), source.empty() ? -1 : getNodeIndex(source),
+                           mode % 2 ? q.tau : 0.0, mode};
+    if(cache->lookup(key, ws.slice))
+        return ws.slice;
+    const vector<int>& result = compute(q, ws);
+    cache->insert(key, result);
+    return result;
+}
+
+// Peels the last field off a line (empty if there is none); what remains of the line may still
+// contain spaces, as graph file names do
+static string peel_field(string& line){
+    size_t end = line.find_last_not_of(" \t\r");
+    if(end == string::npos)
+        return string();
+    size_t begin = line.find_last_of(" \t", end);
+    begin = begin == string::npos ? 0 : begin + 1;
+    string field = line.substr(begin, end + 1 - begin);
+    line.erase(begin);
+    return field;
+}
+
+// Registry of resident ABDGs, shared by the modes working on several graphs (sensitivity study,
+// slice server, cross-graph batches). Every graph file gets a handle, its index in the registry,
+// and every load of it a new version (see graph_version()): a reload swaps the graph of the
+// handle, the holders of the previous version keeping it until they let it go. All graphs are
+// loaded on one shared pool: files under PARALLEL_PARSE_BYTES are parsed concurrently, one per
+// worker, larger ones one after the other, each on the whole pool. Graphs are registered before
+// any query runs; only reloads may race with queries.
+class GraphRegistry {
+    vector<string> files;
+    vector<shared_ptr<const ABDG>> graphs;
+    // Why the last load of every graph failed (empty if it did not)
+    vector<string> errors;
+    mutable mutex graphs_lock;
+    // Reloads parse on the pool one at a time
+    mutex reload_lock;
+    unique_ptr<WorkStealingPool> own;
+    WorkStealingPool* pool;
+    SliceCache* cache;
+    NodeOrder order;
+
+    static const size_t PARALLEL_PARSE_BYTES = 1 << 20;
+    shared_ptr<ABDG> make(const string& file, WorkStealingPool* parser, string& error) const;
+
+public:
+    explicit GraphRegistry(WorkStealingPool* pool = nullptr, SliceCache* cache = nullptr, NodeOrder order = TYPE_ORDER);
+    vector<int> load(const vector<string>& graph_files);
+    int handle(const string& file) const;
+    size_t size() const{ return files.size(); }
+    const string& file(int h) const{ return files[h]; }
+    const string& error(int h) const{ return errors[h]; }
+    shared_ptr<const ABDG> current(int h) const;
+    string reload(int h);
+    void run_batch(const string& query_file) const;
+};
+
+// Without a pool, the registry has one over all cores
+GraphRegistry::GraphRegistry(WorkStealingPool* pool, SliceCache* cache, NodeOrder order)
+    : pool(pool), cache(cache), order(order){
+    if(!pool){
+        own.reset(new WorkStealingPool(0));
+        this->pool = own.get();
+    }
+}
+
+// Null, with the reason, if the file cannot be loaded
+shared_ptr<ABDG> GraphRegistry::make(const string& file, WorkStealingPool* parser, string& error) const{
+    shared_ptr<ABDG> G(new ABDG(file, parser, order, &error));
+    if(!error.empty())
+        return nullptr;
+    G->use_cache(cache);
+    return G;
+}
+
+// Handles of the graph files, in order; a file already registered keeps its handle and graph.
+// The graph of a file that cannot be loaded is null, and error() tells why.
+vector<int> GraphRegistry::load(const vector<string>& graph_files){
+    vector<int> handles;
+    vector<int> small, large;
+    for(const string& file : graph_files){
+        int h = handle(file);
+        if(h < 0){
+            h = files.size();
+            files.push_back(file);
+            graphs.push_back(nullptr);
+            errors.push_back("Could not open input file " + file);
+            ifstream in(file, ios::binary | ios::ate);
+            if(in.good())
+                (size_t(in.tellg()) < PARALLEL_PARSE_BYTES ? small : large).push_back(h);
+        }
+        handles.push_back(h);
+    }
+
+    vector<shared_ptr<const ABDG>> loaded(files.size());
+    vector<string> failed(files.size());
+    pool->run(small.size(), [&](int, size_t i){
+        WorkStealingPool serial(1);
+        loaded[small[i]] = make(files[small[i]], &serial, failed[small[i]]);
+    });
+    for(int h : large)
+        loaded[h] = make(files[h], pool, failed[h]);
+    lock_guard<mutex> lock(graphs_lock);
+    for(size_t h = 0; h < files.size(); h++)
+        if(loaded[h]){
+            graphs[h] = loaded[h];
+            errors[h].clear();
+        }
+        else if(!failed[h].empty())
+            errors[h] = failed[h];
+    return handles;
+}
+
+// -1 if the file is not registered
+int GraphRegistry::handle(const string& file) const{
+    size_t h = find(files.begin(), files.end(), file) - files.begin();
+    return h == files.size() ? -1 : int(h);
+}
+
+shared_ptr<const ABDG> GraphRegistry::current(int h) const{
+    lock_guard<mutex> lock(graphs_lock);
+    return graphs[h];
+}
+
+// Reads the graph file of the handle again; the cached slices of the old version are dropped.
+// If the file cannot be loaded, the old version stays in service.
+string GraphRegistry::reload(int h){
+    lock_guard<mutex> reloading(reload_lock);
+    string error;
+    shared_ptr<const ABDG> G = make(files[h], pool, error);
+    if(!G)
+        return "Error: " + error + "\n";
+    shared_ptr<const ABDG> old;
+    {
+        lock_guard<mutex> lock(graphs_lock);
+        old = graphs[h];
+        graphs[h] = G;
+    }
+    if(cache && old)
+        cache->invalidate(old->graph_version());
+    return "Reloaded " + files[h] + " (version " + to_string(G->graph_version()) + ")\n";
+}
+
+// Answers every query on every graph, one pool task per (graph, query); lines are prefixed
+// with the graph file, in registry order
+void GraphRegistry::run_batch(const string& query_file) const{
+    vector<SliceQuery> queries = ABDG::read_queries(query_file, nullptr);
+    vector<shared_ptr<const ABDG>> snapshot;
+    for(size_t h = 0; h < files.size(); h++)
+        snapshot.push_back(current(h));
+    size_t count = queries.size();
+    vector<string> results(snapshot.size() * count);
+    vector<vector<unique_ptr<SliceScratch>>> scratch(pool->size());
+    for(auto& worker : scratch)
+        worker.resize(snapshot.size());
+
+    pool->run(results.size(), [&](int worker, size_t task){
+        size_t h = task / count;
+        const SliceQuery& q = queries[task % count];
+        const ABDG* G = snapshot[h].get();
+        if(!G || !G->valid_criterion(q))
+            return;
+        unique_ptr<SliceScratch>& ws = scratch[worker][h];
+        if(!ws)
+            ws.reset(new SliceScratch(G->make_scratch()));
+        results[task] = files[h] + " " + G->answer_query(q, *ws);
+    });
+
+    for(size_t h = 0; h < snapshot.size(); h++){
+        if(!snapshot[h]){
+            cerr << "Error: Could not open input file " << files[h] << endl;
+            continue;
+        }
+        for(size_t i = 0; i < count; i++){
+            const string& line = results[h * count + i];
+            if(line.empty())
+                cerr << "Error: Unknown slice criterion " << queries[i].criterion << " in " << files[h] << endl;
+            else
+                cout << line;
+        }
+    }
+    cout.flush();
+}
+
+// Weight sensitivity of pruned slices (see sensitivity_analysis_dsabm.py). Spec lines are
+// graph_file criterion tau; each sample scales every edge type by a factor in [0.8, 1.2]
+void ABDG::run_sensitivity(const string& spec_file, int samples, uint64_t seed, WorkStealingPool& pool, NodeOrder order){
+    const int L = SENSITIVITY_LANES;
+    ifstream spec(spec_file);
+    if(!spec.is_open()){
+        cerr << "Error: Could not open sensitivity file " << spec_file << endl;
+        exit(1);
+    }
+    auto start = chrono::steady_clock::now();
+
+    // Criteria: graph files may contain spaces, so the last two fields are criterion and tau
+    struct Case {
+        string graph, criterion;
+        double tau;
+        int g, start_node;
+    };
+    vector<Case> cases;
+    vector<string> graph_files;
+    string line;
+    while(getline(spec, line)){
+        size_t first = line.find_first_not_of(" \t\r");
+        if(first == string::npos || line[first] == '#')
+            continue;
+        string original = line;
+        Case c;
+        string tau = peel_field(line);
+        c.criterion = peel_field(line);
+        size_t end = line.find_last_not_of(" \t");
+        if(c.criterion.empty() || end == string::npos){
+            cerr << "Error: Malformed sensitivity case: " << original << endl;
+            continue;
+        }
+        c.graph = line.substr(first, end + 1 - first);
+        c.tau = atof(tau.c_str());
+        c.g = find(graph_files.begin(), graph_files.end(), c.graph) - graph_files.begin();
+        if(c.g == int(graph_files.size()))
+            graph_files.push_back(c.graph);
+        cases.push_back(c);
+    }
+    GraphRegistry registry(&pool, nullptr, order);
+    registry.load(graph_files);
+    vector<shared_ptr<const ABDG>> graphs;
+    for(size_t g = 0; g < graph_files.size(); g++){
+        graphs.push_back(registry.current(g));
+        if(!graphs.back())
+            cerr << "Error: " << registry.error(g) << endl;
+    }
+    for(Case& c : cases){
+        c.start_node = -1;
+        if(graphs[c.g] && graphs[c.g]->valid_node(c.criterion))
+            c.start_node = graphs[c.g]->getNodeIndex(c.criterion);
+        else if(graphs[c.g])
+            cerr << "Error: Unknown slice criterion " << c.criterion << endl;
+    }
+
+    // Weight blocks: block 0 holds the unperturbed weights, blocks 1.. the samples
+    int blocks = (samples + L - 1) / L;
+    vector<double> weights(size_t(blocks + 1) * EDGE_TYPES * L, 0.0);
+    mt19937_64 rng(seed);
+    uniform_real_distribution<double> factor(0.8, 1.2);
+    for(int type = 1; type < EDGE_TYPES; type++)
+        for(int l = 0; l < L; l++)
+            weights[type * L + l] = DSABMScheme::weight[type];
+    for(int s = 0; s < blocks * L; s++)
+        for(int type = 1; type < EDGE_TYPES; type++)
+            weights[size_t(s / L + 1) * EDGE_TYPES * L + type * L + s % L] =
+                min(1.0, max(0.01, DSABMScheme::weight[type] * factor(rng)));
+
+    int max_n = 0;
+    for(auto& G : graphs)
+        if(G)
+            max_n = max(max_n, G->n);
+    vector<SensitivityScratch> scratch(pool.size());
+    vector<int> sizes(cases.size() * (blocks + 1) * L, 0);
+    pool.run(cases.size() * (blocks + 1), [&](int worker, size_t task){
+        const Case& c = cases[task / (blocks + 1)];
+        if(c.start_node < 0)
+            return;
+        scratch[worker].resize(max_n);
+        size_t block = task % (blocks + 1);
+        graphs[c.g]->sensitivity(c.start_node, c.tau, &weights[block * EDGE_TYPES * L], scratch[worker], &sizes[task * L]);
+    });
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "# " << samples << " samples, seed " << seed << ", " << pool.size() << " threads, "
+         << fixed << setprecision(3) << elapsed << " s\n";
+    cout << left << setw(25) << "Graph Source" << " | " << setw(9) << "Criterion" << " | " << setw(6) << "Tau" << " | "
+         << setw(10) << "Base Size" << " | " << setw(22) << "Mean Size (Perturbed)" << " | " << setw(10) << "Variance"
+         << " | " << "Std Dev" << "\n";
+    cout << string(110, '-') << "\n";
+    for(size_t i = 0; i < cases.size(); i++){
+        const Case& c = cases[i];
+        cout << setw(25) << c.graph << " | " << setw(9) << c.criterion << " | " << setprecision(2) << setw(6) << c.tau << " | ";
+        if(c.start_node < 0){
+            cout << (graphs[c.g] ? "Unknown criterion" : "File Missing") << "\n";
+            continue;
+        }
+        // Mean and population variance of the sample sizes
+        const int* first = &sizes[i * (blocks + 1) * L];
+        double mean = 0.0, variance = 0.0;
+        for(int s = 0; s < samples; s++)
+            mean += first[L + s];
+        mean /= samples;
+        for(int s = 0; s < samples; s++)
+            variance += (first[L + s] - mean) * (first[L + s] - mean);
+        variance /= samples;
+        cout << setw(10) << first[0] << " | " << setw(22) << mean << " | " << setw(10) << variance << " | "
+             << sqrt(variance) << "\n";
+    }
+    cout.unsetf(ios::floatfield);
+    cout << right << setprecision(6);
+    cout.flush();
+}
+
+// One output line: criterion tau mode |slice| : slice
+string ABDG::answer_query(const SliceQuery& q, SliceScratch& ws) const{
+    const vector<int>& result = slice(q, ws);
+    ostringstream line;
+    line << q.criterion << " " << q.tau << " " << q.mode << " " << result.size() << " :";
+    for(int idx : result)
+        line << " " << node_name(idx);
+    line << "\n";
+    return line.str();
+}
+
+// With a timing stream, the latency of every query (microseconds) is recorded as: criterion latency
+void ABDG::run_batch(const string& query_file, ostream* timing) const{
+    SliceScratch ws = make_scratch();
+    for(const SliceQuery& q : read_queries(query_file, this)){
+        auto start = chrono::steady_clock::now();
+        string line = answer_query(q, ws);
+        chrono::duration<double, micro> elapsed = chrono::steady_clock::now() - start;
+        cout << line;
+        if(timing)
+            *timing << q.criterion << " " << elapsed.count() << "\n";
+    }
+    cout.flush();
+}
+
+// Answers the queries on all workers of the pool. Each worker has its own scratch and every
+// answer goes to its own slot, so results are collected without locking and printed in order.
+void ABDG::run_parallel(const string& query_file, WorkStealingPool& pool, ostream* timing) const{
+    vector<SliceQuery> queries = read_queries(query_file, this);
+    vector<SliceScratch> scratch(pool.size(), make_scratch());
+    vector<string> results(queries.size());
+    vector<double> latency(queries.size());
+
+    pool.run(queries.size(), [&](int worker, size_t i){
+        auto start = chrono::steady_clock::now();
+        results[i] = answer_query(queries[i], scratch[worker]);
+        latency[i] = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+    });
+
+    for(const string& line : results)
+        cout << line;
+    cout.flush();
+    if(timing)
+        for(size_t i = 0; i < queries.size(); i++)
+            *timing << queries[i].criterion << " " << latency[i] << "\n";
+}
+
+// Benchmarks the slice computation of every query on one pinned thread (see bench_harness.h);
+// one line per query, labelled criterion/mode/tau
+void ABDG::run_bench(const string& query_file, const BenchConfig& config) const{
+    SliceScratch ws = make_scratch();
+    PerfCounters counters;
+    print_bench_header(cout, config, pin_thread(config.cpu), counters);
+    vector<BenchResult> results;
+    for(const SliceQuery& q : read_queries(query_file, this)){
+        results.push_back(bench([&]{ slice(q, ws); }, config, counters));
+        ostringstream label;
+        label << q.criterion << "/" << q.mode << "/" << q.tau;
+        print_bench_result(cout, label.str(), results.back());
+    }
+    print_bench_summary(cout, results);
+    cout.flush();
+}
+
+// Slices of registered criteria kept up to date while nodes are added to and edges are inserted
+// into and removed from a live ABDG (a copy of a loaded one, or one built from scratch). Every watch keeps the relevance of each (node, phase) state and the
+// state and edge type it was last improved through (its parent), so that
+//  - an insertion re-propagates only the states it improves (max-heap, as in propagate())
+//  - a removal resets the states whose parent chain used the edge, re-derives them from the
+//    unaffected states around them and re-propagates inside that region only
+// Unweighted (dsabm) watches give every edge the weight 1, i.e. plain three-phase reachability.
+class DynamicSlices {
+    struct Watch {
+        int criterion;
+        double tau;
+        bool weighted;
+        vector<double> state_relevance;
+        vector<int> parent;
+        vector<uint8_t> parent_type;
+        vector<double> node_relevance;
+        unordered_set<int> members;
+    };
+    typedef priority_queue<pair<double, int>> Heap;
+
+    // Node names in order of addition, and their ids
+    vector<string> names;
+    unordered_map<string, int> ids;
+    // Incoming (tail, type) and outgoing (head, type) edges of every node
+    vector<vector<pair<int, uint8_t>>> in, out;
+    vector<Watch> watches;
+
+    double weight(const Watch& w, int type) const{ return w.weighted ? DSABMScheme::weight[type] : 1.0; }
+    void set_node_relevance(Watch& w, int u, double relevance);
+    void recompute_node(Watch& w, int u);
+    void drain(Watch& w, Heap& heap);
+    void inserted(Watch& w, int u, int v, int type);
+    void removed(Watch& w, int u, int v, int type);
+    bool parse_edge(const string& tail, const string& head, int type, int& u, int& v) const;
+
+public:
+    DynamicSlices();
+    explicit DynamicSlices(const ABDG& G);
+    int size() const{ return names.size(); }
+    const string& node_name(int v) const{ return names[v]; }
+    int node_id(const string& name) const;
+    int add_node(const string& name);
+    void insert_edge(int u, int v, int type);
+    int watch(const string& criterion, double tau, bool weighted);
+    bool insert_edge(const string& tail, const string& head, int type);
+    bool remove_edge(const string& tail, const string& head, int type);
+    double relevance(int id, const string& node) const;
+    string slice(int id) const;
+    string query(const string& criterion, double tau, bool weighted);
+    int watch_count() const{ return watches.size(); }
+    void save(const string& file) const;
+    void run_updates(const string& update_file);
+};
+
+// An ABDG holding only S0
+DynamicSlices::DynamicSlices(){
+    add_node("S0");
+}
+
+DynamicSlices::DynamicSlices(const ABDG& G){
+    // Canonical ids, whatever the node order of G
+    for(int c = 0; c < G.n; c++)
+        add_node(G.node_name(G.internal_id(c)));
+    for(int c = 0; c < G.n; c++){
+        int v = G.internal_id(c);
+        for(uint32_t k = G.IDL_off[v]; k < G.IDL_off[v + 1]; k++){
+            int tail = G.canonical_id(G.IDL_tail[k]);
+            in[c].push_back({tail, G.IDL_type[k]});
+            out[tail].push_back({c, G.IDL_type[k]});
+        }
+    }
+}
+
+// Id of the named node, -1 if there is none
+int DynamicSlices::node_id(const string& name) const{
+    auto it = ids.find(name);
+    return it == ids.end() ? -1 : it->second;
+}
+
+// Adds the named node (no-op if it exists) and returns its id; watches grow with the graph
+int DynamicSlices::add_node(const string& name){
+    auto it = ids.emplace(name, int(names.size()));
+    if(!it.second)
+        return it.first->second;
+    names.push_back(name);
+    in.emplace_back();
+    out.emplace_back();
+    for(Watch& w : watches){
+        w.state_relevance.resize(3 * names.size(), 0.0);
+        w.parent.resize(3 * names.size(), -1);
+        w.parent_type.resize(3 * names.size(), 0);
+        w.node_relevance.resize(names.size(), 0.0);
+    }
+    return it.first->second;
+}
+
+void DynamicSlices::set_node_relevance(Watch& w, int u, double relevance){
+    w.node_relevance[u] = relevance;
+    if(u == w.criterion)
+        return;
+    if(relevance > 0.0)
+        w.members.insert(u);
+    else
+        w.members.erase(u);
+}
+
+// Best relevance with which u joins the slice, from the states its outgoing edges lead to
+void DynamicSlices::recompute_node(Watch& w, int u){
+    double best = 0.0;
+    for(auto& edge : out[u])
+        for(int phase = 1; phase <= 3; phase++){
+            double r = w.state_relevance[3 * edge.first + phase - 1];
+            if(r == 0.0 || DSABMScheme::next[phase - 1][edge.second] < 0)
+                continue;
+            double new_w = r * weight(w, edge.second);
+            if(new_w >= w.tau)
+                best = max(best, new_w);
+        }
+    set_node_relevance(w, u, best);
+}
+
+// Expands the improved states of the heap in decreasing relevance order (see propagate())
+void DynamicSlices::drain(Watch& w, Heap& heap){
+    while(!heap.empty()){
+        pair<double, int> top = heap.top();
+        heap.pop();
+        int state = top.second;
+        if(top.first < w.state_relevance[state])
+            continue;
+        int v = state / 3, phase = state % 3 + 1;
+
+        for(auto& edge : in[v]){
+            int u = edge.first, type = edge.second;
+            int next = DSABMScheme::next[phase - 1][type];
+            if(next < 0)
+                continue;
+            double new_w = top.first * weight(w, type);
+            if(new_w < w.tau || new_w == 0.0)
+                continue;
+            if(new_w > w.node_relevance[u])
+                set_node_relevance(w, u, new_w);
+            if(next == 0)
+                continue;
+
+            int next_state = 3 * u + next - 1;
+            if(new_w <= w.state_relevance[next_state])
+                continue;
+            w.state_relevance[next_state] = new_w;
+            w.parent[next_state] = state;
+            w.parent_type[next_state] = type;
+            heap.push({new_w, next_state});
+        }
+    }
+}
+
+// Edge u -> v was inserted: relax it from every live state of v and propagate the improvements
+void DynamicSlices::inserted(Watch& w, int u, int v, int type){
+    Heap heap;
+    for(int phase = 1; phase <= 3; phase++){
+        double r = w.state_relevance[3 * v + phase - 1];
+        int next = DSABMScheme::next[phase - 1][type];
+        if(r == 0.0 || next < 0)
+            continue;
+        double new_w = r * weight(w, type);
+        if(new_w < w.tau || new_w == 0.0)
+            continue;
+        if(new_w > w.node_relevance[u])
+            set_node_relevance(w, u, new_w);
+        int state = 3 * u + next - 1;
+        if(next == 0 || new_w <= w.state_relevance[state])
+            continue;
+        w.state_relevance[state] = new_w;
+        w.parent[state] = 3 * v + phase - 1;
+        w.parent_type[state] = type;
+        heap.push({new_w, state});
+    }
+    drain(w, heap);
+}
+
+// Edge u -> v was removed (no parallel copy is left): delete and re-derive the states that
+// depended on it, then recompute the nodes whose best contribution may have come from them
+void DynamicSlices::removed(Watch& w, int u, int v, int type){
+    vector<int> affected;
+    unordered_set<int> lost, touched;
+    touched.insert(u);
+    for(int phase = 1; phase <= 3; phase++){
+        int next = DSABMScheme::next[phase - 1][type];
+        int state = 3 * u + next - 1;
+        if(next > 0 && w.parent[state] == 3 * v + phase - 1 && w.parent_type[state] == type && lost.insert(state).second)
+            affected.push_back(state);
+    }
+    // Subtree of the parent forest below the lost states
+    for(size_t i = 0; i < affected.size(); i++){
+        int state = affected[i], x = state / 3, phase = state % 3 + 1;
+        for(auto& edge : in[x]){
+            int next = DSABMScheme::next[phase - 1][edge.second];
+            if(next < 0)
+                continue;
+            touched.insert(edge.first);
+            int child = 3 * edge.first + next - 1;
+            if(next > 0 && w.parent[child] == state && w.parent_type[child] == edge.second && lost.insert(child).second)
+                affected.push_back(child);
+        }
+    }
+    for(int state : affected){
+        w.state_relevance[state] = 0.0;
+        w.parent[state] = -1;
+    }
+    // Re-derive every lost state from its best supporter outside the lost region
+    Heap heap;
+    for(int state : affected){
+        int x = state / 3, want = state % 3 + 1;
+        for(auto& edge : out[x])
+            for(int phase = 1; phase <= 3; phase++){
+                double r = w.state_relevance[3 * edge.first + phase - 1];
+                if(r == 0.0 || DSABMScheme::next[phase - 1][edge.second] != want)
+                    continue;
+                double new_w = r * weight(w, edge.second);
+                if(new_w < w.tau || new_w <= w.state_relevance[state])
+                    continue;
+                w.state_relevance[state] = new_w;
+                w.parent[state] = 3 * edge.first + phase - 1;
+                w.parent_type[state] = edge.second;
+            }
+        if(w.state_relevance[state] > 0.0)
+            heap.push({w.state_relevance[state], state});
+    }
+    drain(w, heap);
+    for(int x : touched)
+        recompute_node(w, x);
+}
+
+bool DynamicSlices::parse_edge(const string& tail, const string& head, int type, int& u, int& v) const{
+    u = node_id(tail);
+    v = node_id(head);
+    if(u < 0 || v < 0 || type < 1 || type > 6){
+        cerr << "Error: Invalid edge " << tail << " " << head << " " << type << endl;
+        return false;
+    }
+    return true;
+}
+
+// Registers a criterion; returns the id of its watch
+int DynamicSlices::watch(const string& criterion, double tau, bool weighted){
+    Watch w;
+    w.criterion = node_id(criterion);
+    w.tau = tau;
+    w.weighted = weighted;
+    w.state_relevance.assign(3 * names.size(), 0.0);
+    w.parent.assign(3 * names.size(), -1);
+    w.parent_type.assign(3 * names.size(), 0);
+    w.node_relevance.assign(names.size(), 0.0);
+    w.state_relevance[3 * w.criterion] = 1.0;
+    Heap heap;
+    heap.push({1.0, 3 * w.criterion});
+    drain(w, heap);
+    watches.push_back(move(w));
+    return watches.size() - 1;
+}
+
+void DynamicSlices::insert_edge(int u, int v, int type){
+    in[v].push_back({u, uint8_t(type)});
+    out[u].push_back({v, uint8_t(type)});
+    for(Watch& w : watches)
+        inserted(w, u, v, type);
+}
+
+bool DynamicSlices::insert_edge(const string& tail, const string& head, int type){
+    int u, v;
+    if(!parse_edge(tail, head, type, u, v))
+        return false;
+    insert_edge(u, v, type);
+    return true;
+}
+
+bool DynamicSlices::remove_edge(const string& tail, const string& head, int type){
+    int u, v;
+    if(!parse_edge(tail, head, type, u, v))
+        return false;
+    pair<int, uint8_t> key(u, type), rev(v, type);
+    auto it = find(in[v].begin(), in[v].end(), key);
+    if(it == in[v].end()){
+        cerr << "Error: No edge " << tail << " " << head << " " << type << endl;
+        return false;
+    }
+    *it = in[v].back();
+    in[v].pop_back();
+    auto jt = find(out[u].begin(), out[u].end(), rev);
+    *jt = out[u].back();
+    out[u].pop_back();
+    // A parallel copy of the edge keeps every slice as it is
+    if(find(in[v].begin(), in[v].end(), key) != in[v].end())
+        return true;
+    for(Watch& w : watches)
+        removed(w, u, v, type);
+    return true;
+}
+
+// Relevance with which the node belongs to the slice of the watch (0 if it does not)
+double DynamicSlices::relevance(int id, const string& node) const{
+    int v = node_id(node);
+    return v < 0 ? 0.0 : watches[id].node_relevance[v];
+}
+
+// Current slice of the watch, as a batch output line: criterion tau mode |slice| : slice, the
+// slice in canonical order (ids follow it, nodes added later come last)
+string DynamicSlices::slice(int id) const{
+    const Watch& w = watches[id];
+    vector<int> members(w.members.begin(), w.members.end());
+    sort(members.begin(), members.end());
+    ostringstream line;
+    line << names[w.criterion] << " " << w.tau << " " << (w.weighted ? "pruned" : "dsabm") << " "
+         << members.size() << " :";
+    for(int u : members)
+        line << " " << names[u];
+    line << "\n";
+    return line.str();
+}
+
+// One-off slice of a criterion that is not kept up to date
+string DynamicSlices::query(const string& criterion, double tau, bool weighted){
+    string line = slice(watch(criterion, tau, weighted));
+    watches.pop_back();
+    return line;
+}
+
+// Writes the live ABDG in the text format, vertices sorted as S0, R*, A*, P*, J* (the order the
+// slicers index them in); node names must follow the S0/Ri/Ai/Pi/Ji scheme
+void DynamicSlices::save(const string& file) const{
+    ofstream fs(file);
+    if(!fs.is_open()){
+        cerr << "Error: Could not open output file " << file << endl;
+        exit(1);
+    }
+    vector<int> order(names.size());
+    for(size_t v = 0; v < names.size(); v++)
+        order[v] = v;
+    const string kinds = "SRAPJ";
+    sort(order.begin(), order.end(), [&](int x, int y){
+        size_t kx = kinds.find(names[x][0]), ky = kinds.find(names[y][0]);
+        if(kx != ky)
+            return kx < ky;
+        return stoi(names[x].substr(1)) < stoi(names[y].substr(1));
+    });
+    size_t edges = 0;
+    for(auto& list : in)
+        edges += list.size();
+    fs << names.size() << "\n";
+    for(size_t i = 0; i < order.size(); i++)
+        fs << names[order[i]] << (i + 1 < order.size() ? " " : "\n");
+    fs << edges << "\n";
+    for(size_t v = 0; v < names.size(); v++)
+        for(auto& edge : in[v])
+            fs << names[edge.first] << " " << names[v] << " " << int(edge.second) << "\n";
+}
+
+// Update script: one command per line, # starts a comment
+//   watch criterion tau mode    register a criterion (mode dsabm or pruned)
+//   insert tail head type       insert an edge
+//   remove tail head type       remove an edge
+//   print                       print the slices of all watches
+void DynamicSlices::run_updates(const string& update_file){
+    ifstream us(update_file);
+    if(!us.is_open()){
+        cerr << "Error: Could not open update file " << update_file << endl;
+        exit(1);
+    }
+    string line, command, a, b, mode;
+    while(getline(us, line)){
+        istringstream ls(line);
+        if(!(ls >> command) || command[0] == '#')
+            continue;
+        int type;
+        double tau;
+        if(command == "print"){
+            for(size_t i = 0; i < watches.size(); i++)
+                cout << slice(i);
+        }
+        else if(command == "watch" && ls >> a >> tau >> mode && node_id(a) >= 0 && (mode == "dsabm" || mode == "pruned")){
+            watch(a, mode == "dsabm" ? 0.0 : tau, mode == "pruned");
+        }
+        else if(command == "insert" && ls >> a >> b >> type)
+            insert_edge(a, b, type);
+        else if(command == "remove" && ls >> a >> b >> type)
+            remove_edge(a, b, type);
+        else
+            cerr << "Error: Malformed update: " << line << endl;
+    }
+    cout.flush();
+}
+
+// Builds a live ABDG from the execution events of a multi-agent system, one event per line
+// (# starts a comment), classifying each into the six edge types as it arrives:
+//   rule <agent> <label>               rule fired          control edge (1) into an R node
+//   activity <agent> <label>           activity executed   control edge (1) into an A node
+//   join <agent> <label>               behaviour joined    control edge (1) into a J node
+//   call <agent> <procedure>           procedure called    call edge (3) caller -> P node
+//   return <agent> <procedure>         procedure returned  return edge (4) P node -> caller
+//   send <agent> <message> <receiver>  message sent        (remembered for the receiver)
+//   receive <agent> <message>          message received    message edge (2) sender -> receiver,
+//                                                          malformed unless sent to the agent
+//   write <agent> <variable>           data written        (remembered as the last writer)
+//   read <agent> <variable>            data read           data edge last writer -> reader,
+//                                                          6 in the same agent, 5 across agents
+// Control edges run from the agent's current node (S0 before its first event); a message
+// received before the receiver's first node goes to that node. A node stands for one
+// (agent, label) pair, so repeated firings reuse it and repeated dependencies add no parallel
+// edges. Interleaved with the events, slices can be asked for at any time:
+//   watch <agent> <label> <tau> <mode>  keep the slice of the node up to date (dsabm or pruned)
+//   slice <agent> <label> <tau> <mode>  print the slice of the node once
+//   print                               print the slices of all watches
+//   save <file>                         write the ABDG (and <file>.labels: name agent label)
+class EventIngestor {
+    struct Agent {
+        int current = 0;
+        // Open procedure calls: procedure node and the node that called it
+        vector<pair<int, int>> calls;
+        // Senders of messages received before the agent's first node
+        vector<int> inbox;
+    };
+
+    DynamicSlices& live;
+    unordered_map<string, Agent> agents;
+    // Node of every (agent, label), and the agent and label of every node
+    unordered_map<string, int> nodes;
+    vector<pair<string, string>> labels;
+    int count[128] = {0};
+    unordered_set<uint64_t> edges;
+    // Sender's node of every (message, receiver)
+    unordered_map<string, int> messages;
+    unordered_map<string, pair<int, string>> writers;
+    // Tokens of the current line and the (agent, label) lookup key, reused across lines
+    vector<string> tokens;
+    string key;
+
+    int node(char kind, const string& agent, const string& label);
+    int find_node(const string& agent, const string& label);
+    void edge(int u, int v, int type);
+    void enter(Agent& state, int v);
+
+public:
+    explicit EventIngestor(DynamicSlices& live) : live(live), labels(1){}
+    bool process(const string& line);
+    void save(const string& file) const;
+    void run(istream& events);
+};
+
+// Node of (agent, label), created with the next name of its kind on first sight
+int EventIngestor::node(char kind, const string& agent, const string& label){
+    key.assign(agent).append(1, '\n').append(label);
+    auto it = nodes.find(key);
+    if(it != nodes.end())
+        return live.node_name(it->second)[0] == kind ? it->second : -1;
+    int v = live.add_node(kind + to_string(++count[int(kind)]));
+    nodes.emplace(key, v);
+    labels.push_back({agent, label});
+    return v;
+}
+
+int EventIngestor::find_node(const string& agent, const string& label){
+    key.assign(agent).append(1, '\n').append(label);
+    auto it = nodes.find(key);
+    return it == nodes.end() ? -1 : it->second;
+}
+
+// Inserts u -> v unless it is a self-loop or already present
+void EventIngestor::edge(int u, int v, int type){
+    if(u != v && edges.insert(uint64_t(u) << 35 | uint64_t(v) << 3 | type).second)
+        live.insert_edge(u, v, type);
+}
+
+// Control flow of the agent moves to node v
+void EventIngestor::enter(Agent& state, int v){
+    edge(state.current, v, 1);
+    for(int sender : state.inbox)
+        edge(sender, v, 2);
+    state.inbox.clear();
+    state.current = v;
+}
+
+// Applies one event or query line; false if it is malformed
+bool EventIngestor::process(const string& line){
+    size_t count = 0;
+    for(size_t i = 0; i < line.size();){
+        while(i < line.size() && is_blank(line[i]))
+            i++;
+        size_t begin = i;
+        while(i < line.size() && !is_blank(line[i]))
+            i++;
+        if(begin == i)
+            break;
+        if(count == tokens.size())
+            tokens.emplace_back();
+        tokens[count++].assign(line, begin, i - begin);
+    }
+    if(count == 0 || tokens[0][0] == '#')
+        return true;
+    const string& event = tokens[0];
+    if(event == "print"){
+        for(int i = 0; i < live.watch_count(); i++)
+            cout << live.slice(i);
+        return true;
+    }
+    if(event == "save")
+        return count == 2 && (save(tokens[1]), true);
+    if(count < 3)
+        return false;
+    const string &agent = tokens[1], &a = tokens[2];
+    Agent& state = agents[agent];
+
+    if(event == "rule" || event == "activity" || event == "join"){
+        int v = node(event == "rule" ? 'R' : event == "activity" ? 'A' : 'J', agent, a);
+        if(v < 0)
+            return false;
+        enter(state, v);
+    }
+    else if(event == "call"){
+        int v = node('P', agent, a);
+        if(v < 0)
+            return false;
+        edge(state.current, v, 3);
+        state.calls.push_back({v, state.current});
+        state.current = v;
+    }
+    else if(event == "return"){
+        int v = find_node(agent, a);
+        auto it = find_if(state.calls.rbegin(), state.calls.rend(), [v](const pair<int, int>& c){ return c.first == v; });
+        if(v < 0 || it == state.calls.rend())
+            return false;
+        edge(v, it->second, 4);
+        state.current = it->second;
+        state.calls.erase(prev(it.base()), state.calls.end());
+    }
+    else if(event == "send"){
+        if(count != 4)
+            return false;
+        messages[a + '\n' + tokens[3]] = state.current;
+    }
+    else if(event == "receive"){
+        auto it = messages.find(a + '\n' + agent);
+        if(it == messages.end())
+            return false;
+        if(state.current)
+            edge(it->second, state.current, 2);
+        else
+            state.inbox.push_back(it->second);
+    }
+    else if(event == "write"){
+        writers[a] = {state.current, agent};
+    }
+    else if(event == "read"){
+        auto it = writers.find(a);
+        if(it != writers.end())
+            edge(it->second.first, state.current, it->second.second == agent ? 6 : 5);
+    }
+    else if(event == "watch" || event == "slice"){
+        int v = find_node(agent, a);
+        if(count != 5 || v < 0 || (tokens[4] != "dsabm" && tokens[4] != "pruned"))
+            return false;
+        double tau = atof(tokens[3].c_str());
+        bool weighted = tokens[4] == "pruned";
+        if(event == "watch")
+            live.watch(live.node_name(v), weighted ? tau : 0.0, weighted);
+        else
+            cout << live.query(live.node_name(v), weighted ? tau : 0.0, weighted);
+    }
+    else
+        return false;
+    return true;
+}
+
+void EventIngestor::save(const string& file) const{
+    live.save(file);
+    ofstream ls(file + ".labels");
+    for(size_t v = 1; v < labels.size(); v++)
+        ls << live.node_name(v) << " " << labels[v].first << " " << labels[v].second << "\n";
+}
+
+void EventIngestor::run(istream& events){
+    string line;
+    while(getline(events, line))
+        if(!process(line))
+            cerr << "Error: Malformed event: " << line << endl;
+    cout.flush();
+}
+
+// Slice daemon: the ABDGs are loaded once and stay resident, answering one request per line
+//   [graph_file] criterion tau mode
+// where graph_file is one of the files given at startup (it may be left out when only one is
+// loaded). Every request gets one response line: the batch output line (criterion tau mode
+// |slice| : slice) or "Error: <message>"; blank lines and lines starting with # get none.
+// Requests come from standard input, the responses going to standard output and being flushed
+// whenever no further request is buffered, or from the clients of a Unix domain socket, every
+// client on a thread of its own. The ABDGs are read-only, so the clients share them and only
+// own their traversal buffers. Two control requests complete the protocol:
+//   reload <graph_file>   reads the graph file again (clients switch to the new version, and
+//                         the cached slices of the old one are dropped; a file that cannot be
+//                         loaded is an Error reply, and the old version stays in service)
+//   stats                 one line of slice cache statistics (see SliceCache)
+class SliceServer {
+    GraphRegistry& graphs;
+    SliceCache* cache;
+    // Traversal buffers of a client, one per graph, made on first use and remade for a new version
+    struct Buffer {
+        uint64_t version = 0;
+        unique_ptr<SliceScratch> scratch;
+    };
+    typedef vector<Buffer> Buffers;
+
+    string respond(string line, Buffers& buffers);
+#ifndef _WIN32
+    void serve_client(int fd);
+#endif
+
+public:
+    SliceServer(GraphRegistry& graphs, SliceCache* cache = nullptr) : graphs(graphs), cache(cache){}
+    void run(istream& in, ostream& out);
+    void listen(const string& socket_path);
+};
+
+string SliceServer::respond(string line, Buffers& buffers){
+    size_t first = line.find_first_not_of(" \t\r");
+    if(first == string::npos || line[first] == '#')
+        return string();
+    string original = line.substr(0, line.find_last_not_of("\r") + 1);
+    if(original.compare(first, 7, "reload ") == 0){
+        size_t begin = original.find_first_not_of(" \t", first + 7), end = original.find_last_not_of(" \t");
+        string file = begin == string::npos ? string() : original.substr(begin, end + 1 - begin);
+        int h = graphs.handle(file);
+        return h < 0 ? "Error: Unknown graph " + file + "\n" : graphs.reload(h);
+    }
+    if(original.find_last_not_of(" \t") + 1 - first == 5 && original.compare(first, 5, "stats") == 0){
+        if(!cache)
+            return "Error: No slice cache (see -l)\n";
+        ostringstream out;
+        cache->report(out);
+        return out.str();
+    }
+    SliceQuery q;
+    q.mode = peel_field(line);
+    string tau = peel_field(line);
+    q.criterion = peel_field(line);
+    size_t end = line.find_last_not_of(" \t");
+    string graph = end == string::npos ? string() : line.substr(first, end + 1 - first);
+    char* rest;
+    q.tau = strtod(tau.c_str(), &rest);
+    if(q.criterion.empty() || tau.empty() || *rest)
+        return "Error: Malformed request: " + original + "\n";
+
+    int g = 0;
+    if(graph.empty() && graphs.size() > 1)
+        return "Error: Missing graph (" + to_string(graphs.size()) + " are loaded)\n";
+    if(!graph.empty() && (g = graphs.handle(graph)) < 0)
+        return "Error: Unknown graph " + graph + "\n";
+    shared_ptr<const ABDG> G = graphs.current(g);
+    if(mode_index(q.mode) < 0)
+        return "Error: Unsupported mode " + q.mode + " (expected " + SLICE_MODE_LIST + ")\n";
+    if(!read_top_k(q))
+        return "Error: Expected a whole number k in [0, 2^31) for topk: " + original + "\n";
+    if(!G->valid_criterion(q))
+        return "Error: Unknown slice criterion " + q.criterion + "\n";
+    if(buffers.size() < graphs.size())
+        buffers.resize(graphs.size());
+    Buffer& buffer = buffers[g];
+    if(buffer.version != G->graph_version()){
+        buffer.scratch.reset(new SliceScratch(G->make_scratch()));
+        buffer.version = G->graph_version();
+    }
+    return G->answer_query(q, *buffer.scratch);
+}
+
+void SliceServer::run(istream& in, ostream& out){
+    Buffers buffers;
+    string line;
+    while(getline(in, line)){
+        out << respond(line, buffers);
+        if(in.rdbuf()->in_avail() <= 0)
+            out.flush();
+    }
+    out.flush();
+}
+
+#ifndef _WIN32
+// Writes the whole buffer to the descriptor; false if the peer is gone
+static bool write_all(int fd, const string& data){
+    size_t done = 0;
+    while(done < data.size()){
+        ssize_t k = write(fd, data.data() + done, data.size() - done);
+        if(k < 0 && errno == EINTR)
+            continue;
+        if(k <= 0)
+            return false;
+        done += k;
+    }
+    return true;
+}
+
+// Answers the requests of one client until it disconnects; the responses to the requests of
+// one read go out in one write
+void SliceServer::serve_client(int fd){
+    Buffers buffers;
+    string pending, responses;
+    char chunk[1 << 16];
+    while(true){
+        ssize_t k = read(fd, chunk, sizeof(chunk));
+        if(k < 0 && errno == EINTR)
+            continue;
+        if(k <= 0)
+            break;
+        pending.append(chunk, k);
+        size_t begin = 0, end;
+        while((end = pending.find('\n', begin)) != string::npos){
+            responses += respond(pending.substr(begin, end - begin), buffers);
+            begin = end + 1;
+        }
+        pending.erase(0, begin);
+        if(!write_all(fd, responses))
+            break;
+        responses.clear();
+    }
+    // A last request without a newline
+    if(!pending.empty())
+        write_all(fd, respond(pending, buffers));
+    close(fd);
+}
+#endif
+
+void SliceServer::listen(const string& socket_path){
+#ifdef _WIN32
+    cerr << "Error: Unix domain sockets are not supported on this platform (use - for standard input)" << endl;
+    exit(1);
+#else
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if(socket_path.size() >= sizeof(address.sun_path)){
+        cerr << "Error: Socket path too long: " << socket_path << endl;
+        exit(1);
+    }
+    strcpy(address.sun_path, socket_path.c_str());
+    unlink(socket_path.c_str());
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(fd < 0 || bind(fd, (sockaddr*)&address, sizeof(address)) < 0 || ::listen(fd, 64) < 0){
+        cerr << "Error: Could not listen on socket " << socket_path << endl;
+        exit(1);
+    }
+    // A client leaving early must not kill the server
+    signal(SIGPIPE, SIG_IGN);
+    cerr << "Listening on " << socket_path << endl;
+    while(true){
+        int client = accept(fd, nullptr, nullptr);
+        if(client < 0){
+            if(errno == EINTR || errno == ECONNABORTED)
+                continue;
+            cerr << "Error: Could not accept a client on " << socket_path << endl;
+            break;
+        }
+        thread(&SliceServer::serve_client, this, client).detach();
+    }
+    close(fd);
+#endif
+}
+
+// Usage: dsabm_integrated [-g graph_file] [-t threads] [-o order] [-x binary_file] [-p timing_file]
+//                         [-n iterations] [-w warmup] [-k cpu] [-l cache_mb] [query_file | -c [criterion ...] | -u update_file]
+//        dsabm_integrated -e event_file
+//        dsabm_integrated [-t threads] [-m samples] [-r seed] -s sensitivity_file
+//        dsabm_integrated [-g graph_file] [-t threads] [-l cache_mb] -d socket_path|- [graph_file ...]
+//        dsabm_integrated [-g graph_file] [-t threads] [-l cache_mb] -a query_file [graph_file ...]
+// The graph file may be in the text or in the binary format; -x converts it to the binary format.
+// -o rcm|agent renumbers the nodes of every loaded graph for locality (see ABDG::reorder()); names and
+// results are unchanged, only nodes found at the same point of a traversal may come in another
+// order. The default, type, keeps the order of the files.
+// Batch queries are lines criterion tau mode: dsabm and pruned ask for the (backward) slice of the
+// criterion, forward and forward_pruned for the nodes whose slice contains it (impact analysis),
+// chop for the nodes on the paths from a source to a target, given as criterion source:target,
+// and topk for the k most relevant nodes of the slice (k, a whole number, in place of tau), by
+// decreasing relevance.
+// -p records the load time and the latency of every batch query, in microseconds.
+// -n iterations benchmarks the batch queries instead, with -w warmup runs on cpu -k.
+// -u replays an update script (see DynamicSlices::run_updates()) against a live copy of the ABDG.
+// -e builds an ABDG from an execution event stream (see EventIngestor; - reads standard input).
+// -s runs the weight sensitivity study of ABDG::run_sensitivity() (default 1000 samples, seed 42).
+// -d serves slice requests on a Unix domain socket or, with -, on standard input (see SliceServer)
+//    from the listed graph files, the -g one if none are listed.
+// -a answers the batch queries on every listed graph (the -g one if none are listed), all graphs
+//    at once on the pool (see GraphRegistry::run_batch()); lines are prefixed with the graph file.
+// -l puts an LRU cache of the given size (MB) in front of the batch and server queries (see
+//    SliceCache); batch mode reports its statistics on standard error.
+int main(int argc, char* argv[]){
+    string graph_file = "input_file.txt", binary_file, timing_file;
+    int threads = -1;
+    BenchConfig config;
+    bool bench_mode = false;
+    int samples = 1000;
+    double cache_mb = 0;
+    uint64_t seed = 42;
+    string order_name = NODE_ORDERS[TYPE_ORDER];
+    int arg = 1;
+    const string options[] = {"-g", "-t", "-x", "-p", "-n", "-w", "-k", "-m", "-r", "-l", "-o"};
+    while(arg + 1 < argc && find(begin(options), end(options), argv[arg]) != end(options)){
+        string option = argv[arg];
+        if(option == "-g")
+            graph_file = argv[arg + 1];
+        else if(option == "-x")
+            binary_file = argv[arg + 1];
+        else if(option == "-p")
+            timing_file = argv[arg + 1];
+        else if(option == "-n")
+            config.iterations = atoi(argv[arg + 1]), bench_mode = true;
+        else if(option == "-w")
+            config.warmup = atoi(argv[arg + 1]);
+        else if(option == "-k")
+            config.cpu = atoi(argv[arg + 1]);
+        else if(option == "-m")
+            samples = atoi(argv[arg + 1]);
+        else if(option == "-r")
+            seed = strtoull(argv[arg + 1], nullptr, 10);
+        else if(option == "-l")
+            cache_mb = atof(argv[arg + 1]);
+        else if(option == "-o")
+            order_name = argv[arg + 1];
+        else
+            threads = atoi(argv[arg + 1]);
+        arg += 2;
+    }
+    const char* const* known = find(begin(NODE_ORDERS), end(NODE_ORDERS), order_name);
+    if(known == end(NODE_ORDERS)){
+        cerr << "Error: Unknown node order " << order_name << " (expected type, rcm or agent)" << endl;
+        exit(1);
+    }
+    NodeOrder order = NodeOrder(known - begin(NODE_ORDERS));
+    // Ingestion mode: the ABDG comes from the event stream instead of a graph file
+    if(arg + 1 < argc && string(argv[arg]) == "-e"){
+        ios::sync_with_stdio(false);
+        DynamicSlices live;
+        EventIngestor ingestor(live);
+        if(string(argv[arg + 1]) == "-")
+            ingestor.run(cin);
+        else{
+            ifstream events(argv[arg + 1]);
+            if(!events.is_open()){
+                cerr << "Error: Could not open event file " << argv[arg + 1] << endl;
+                exit(1);
+            }
+            ingestor.run(events);
+        }
+        return 0;
+    }
+    unique_ptr<WorkStealingPool> pool;
+    if(threads >= 0)
+        pool.reset(new WorkStealingPool(threads));
+    unique_ptr<SliceCache> cache;
+    if(cache_mb > 0)
+        cache.reset(new SliceCache(size_t(cache_mb * (1 << 20))));
+    // Sensitivity mode: perturbed-weight slice sizes over the graphs of the spec file (all cores by default)
+    if(arg + 1 < argc && string(argv[arg]) == "-s"){
+        if(arg + 2 < argc){
+            cerr << "Error: Unexpected argument " << argv[arg + 2] << " after the sensitivity file (options go before -s)" << endl;
+            exit(1);
+        }
+        if(samples < 1){
+            cerr << "Error: Expected at least one sample (-m)" << endl;
+            exit(1);
+        }
+        if(!pool)
+            pool.reset(new WorkStealingPool(0));
+        ABDG::run_sensitivity(argv[arg + 1], samples, seed, *pool, order);
+        return 0;
+    }
+    // Multi-graph modes: the ABDGs are loaded concurrently into one registry sharing the pool. The
+    // server answers requests until the input ends or it is stopped; -a answers a batch on all.
+    if(arg + 1 < argc && (string(argv[arg]) == "-d" || string(argv[arg]) == "-a")){
+        vector<string> files(argv + arg + 2, argv + argc);
+        if(files.empty())
+            files.push_back(graph_file);
+        ios::sync_with_stdio(false);
+        GraphRegistry registry(pool.get(), cache.get(), order);
+        for(int h : registry.load(files))
+            if(!registry.current(h)){
+                cerr << "Error: " << registry.error(h) << endl;
+                exit(1);
+            }
+        if(string(argv[arg]) == "-a"){
+            registry.run_batch(argv[arg + 1]);
+            if(cache)
+                cache->report(cerr);
+            return 0;
+        }
+        SliceServer server(registry, cache.get());
+        if(string(argv[arg + 1]) == "-")
+            server.run(cin, cout);
+        else
+            server.listen(argv[arg + 1]);
+        return 0;
+    }
+    auto start = chrono::steady_clock::now();
+    ABDG G(graph_file, pool.get(), order);
+    ofstream timing;
+    if(!timing_file.empty()){
+        timing.open(timing_file);
+        if(!timing.is_open()){
+            cerr << "Error: Could not open timing file " << timing_file << endl;
+            exit(1);
+        }
+        timing << "load " << chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() << "\n";
+    }
+
+    // Converter: write the loaded ABDG in the binary format
+    if(!binary_file.empty()){
+        G.save_binary(binary_file);
+        if(arg == argc)
+            return 0;
+    }
+
+    // Calibration mode: one relevance profile per criterion (every node if none are given)
+    if(arg < argc && string(argv[arg]) == "-c"){
+        ios::sync_with_stdio(false);
+        G.calibrate(vector<string>(argv + arg + 1, argv + argc));
+        return 0;
+    }
+    // Dynamic mode: watched slices maintained under edge insertions and removals
+    if(arg + 1 < argc && string(argv[arg]) == "-u"){
+        ios::sync_with_stdio(false);
+        DynamicSlices(G).run_updates(argv[arg + 1]);
+        return 0;
+    }
+    // Benchmark mode: latency statistics of every query of the given file
+    if(arg < argc && bench_mode){
+        G.run_bench(argv[arg], config);
+        return 0;
+    }
+    // Batch mode: answer every (criterion, tau, mode) query of the given file against the same
+    // ABDG, spread over a work-stealing pool when a thread count is given (0 for all cores)
+    if(arg < argc){
+        ios::sync_with_stdio(false);
+        G.use_cache(cache.get());
+        if(pool)
+            G.run_parallel(argv[arg], *pool, timing.is_open() ? &timing : nullptr);
+        else
+            G.run_batch(argv[arg], timing.is_open() ? &timing : nullptr);
+        if(cache)
+            cache->report(cerr);
+        return 0;
+    }
     // Test multiple thresholds as per your loop
     // for(int i = 1; i <= 10; i++) {
     //     G.display_dynamic_slice(0.1 * i);
     // }
     G.display_dynamic_slice(0.15);
-    _getch();
     return 0;
 }
\ No newline at end of file
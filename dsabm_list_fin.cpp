@@ -15,10 +15,23 @@ Input: 1. Agent Behavior Dependency Graph (ABDG)
         2. Slice Criterion
         - Number of slice criterions, t (positive integer)
         - Slice criterion for each iteration over t, s. s belong to V
+        3. Batch Query File (optional, path given as the first command-line argument)
+        - One query per line in the format: criterion <space> tau <space> mode
+                - criterion belongs to V
+                - tau is a threshold in [0, 1] (ignored by the unweighted DSABM)
+                - mode is dsabm (pruned queries are answered by dsabm_integrated)
+        - Lines starting with # are ignored
+        4. Options: -g graph_file (default input_file.txt), -a to compute the slice of every node,
+           -b index_file to build and save the slice index, -i index_file to answer from a saved index,
+           -p timing_file to record the load time and the latency of every query (in microseconds),
+           -n iterations to benchmark the batch queries instead (see bench_harness.h), with
+           -w warmup runs on cpu -k
 Output: 1. A list of vertex with their index as prefix
         2. Incedent-Dependency List of |V| vector entries, each representing a vertex Vi
         - Each vector contains the tail, u of incident edges u -> Vi (of which Vi is a head) and their nature (an integer from [1-6] as per the above-mentioned notation)
+        - Kept in CSR form, the SliceCSR of dsabm_slicer.h
         3. Dynamic slice as computed using Dynamic Slicing algorithm for Agent Behavior Model (DSABM) corresponding each slice criterion
+        4. In batch mode, one line per query: criterion tau mode |slice| : slice
 Author: Jibesh Kumar Panda
         - Version 1.2
         - Date: 11.01.2025
@@ -28,56 +41,64 @@ Author: Jibesh Kumar Panda
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <sstream>
 #include <vector>
-#include <unordered_set>
 #include <array>
 #include <string>
+#include <cstdint>
+#include <algorithm>
+#include <chrono>
 // #include <cstdlib>
-#include <conio.h>
 using namespace std;
+#include "bench_harness.h"
+#include "dsabm_slicer.h"
 
-class ABDG{
-        // Number of Vertices (For initialization of Graph Representation)
-        int n;
-        // Set of Vertices
-        string *V;
-        // Number of Edges
-        int e;
-        // Number of rule nodes, activity nodes, and procedure nodes
-        int r, a, p;
-        // Incident-Dependency List
-        vector<vector<pair<string, int>>> IDL;
-        // To be computed internally
-        void update_r_a_p();
-        // Method to sort the nodes
-        void sort_V();
-        // Method to map a node to index
-        int index(const string&);
-        // Method to initialize dependency matrix
-        void initialize_incident_dependency_list();
-        // Method to add dependencies
-        void add_edges();
+// Number of 64-bit words of criteria per node in the multi-source DSABM: a traversal answers
+// 64 * LANE_WORDS criteria. Build with -DDSABM_LANE_WORDS=4 for 256; a wider lane block costs
+// more per visited node, so fewer traversals are not always faster.
+#ifndef DSABM_LANE_WORDS
+#define DSABM_LANE_WORDS 1
+#endif
+const int LANE_WORDS = DSABM_LANE_WORDS;
+const int LANES = LaneScratch<LANE_WORDS>::LANES;
+
+class ABDG : public SliceCSR{
+        // Set of Vertices, in index order
+        vector<string> V;
         // Method to compute Dynamic Slice (Implementation of DSABM)
-        unordered_set<int> DSABM(const string& s);
-        // File Stream
-        fstream fs;
+        const vector<int>& DSABM(const string& s);
+        // Method to print the slices of the given criteria, LANES criteria per traversal
+        // (with timing, every criterion is charged an equal share of its traversal)
+        void print_slices(const vector<string>& criteria, const vector<double>& taus, ostream* timing = nullptr);
+        // Traversal buffers, sized to the graph and reused across queries: those of the DSABM
+        // and those of the multi-source DSABM
+        SliceScratch ws;
+        LaneScratch<LANE_WORDS> lanes;
+        // Slice index: the slice of criterion v (plus v itself if it lies on a cycle) is the
+        // bitset idx_bits[idx_slot[v] * idx_words .. + idx_words); criteria sharing a phase-1 SCC
+        // share a slot
+        vector<uint32_t> idx_slot;
+        vector<uint64_t> idx_bits;
+        size_t idx_words = 0;
+        // Method to fingerprint the Incident-Dependency List (detects stale index files)
+        uint64_t graph_checksum();
+        // Method to decode the indexed slice of node v
+        void indexed_slice(int v, vector<int>& result);
     public:
         // Constructor
-        ABDG();
-        // Destructor
-        ~ABDG();
+        ABDG(const string& file = "input_file.txt");
         // Method to show all vertices
         void show_vertices(){
             for(int i = 0; i < n - 1; i++)
-                cout<<index(V[i])<<":"<<V[i]<<", ";
-            cout<<index(V[n - 1])<<":"<<V[n - 1]<<endl;
+                cout<<i<<":"<<V[i]<<", ";
+            cout<<n - 1<<":"<<V[n - 1]<<endl;
         }
         // Method to show dependency matrix
         void show_incident_dependency_list(){
             for(int i = 0; i < n; i++){
                 cout<<V[i]<<": ";
-                for(auto p : IDL[i])
-                    cout<<"- "<<p.first<<"|"<<p.second<<" ";
+                for(uint32_t k = IDL_off[i]; k < IDL_off[i + 1]; k++)
+                    cout<<"- "<<V[IDL_tail[k]]<<"|"<<int(IDL_type[k])<<" ";
                 cout<<endl;
             }
         }
@@ -86,178 +107,429 @@ class ABDG{
             string s;
             cout<<"Enter the slice criterion (node): ";
             cin>>s;
-            unordered_set<int> tempDS = DSABM(s);
+            if(index(s) < 0){
+                cerr<<"Error: Unknown slice criterion "<<s<<endl;
+                exit(1);
+            }
+            const vector<int>& tempDS = DSABM(s);
             if(tempDS.size())
                 cout<<"Dynamic Slice Set corresponding criterion "<<s<<" is:"<<endl;
             for(auto v : tempDS)
                 cout<<V[v]<<" ";
             cout<<endl;
         }
+        // Method to read the dsabm queries of a batch query file
+        void read_queries(const string& query_file, vector<string>& criteria, vector<double>& taus);
+        // Method to answer every query of a batch query file
+        void run_batch(const string& query_file, ostream* timing = nullptr);
+        // Method to benchmark every query of a batch query file (one criterion per traversal)
+        void run_bench(const string& query_file, const BenchConfig& config);
+        // Method to display the Dynamic Slice of every node
+        void run_all();
+        // Method to precompute the slices of all criteria (SCC condensation + DP)
+        void build_slice_index();
+        // Methods to persist the slice index
+        void save_slice_index(const string& index_file);
+        void load_slice_index(const string& index_file);
 };
 
-// Method definition for update_r_a_p()
-void ABDG::update_r_a_p(){
-    r = a = p = 0;
-    for(int i = 0; i < n; i++){
-        if(V[i][0] == 'R')
-            r++;
-        else if(V[i][0] == 'A')
-            a++;
-        else if(V[i][0] == 'P')
-            p++;
-    }
+// Method definition for DSABM()
+const vector<int>& ABDG::DSABM(const string& s){
+    return DSABM_kernel<DSABMScheme>(index(s), ws);
 }
 
-// Method definition for sort_V()
-void ABDG::sort_V(){
-    V[0] = "S0";
-    int index = 1;
+// Method definition for build_slice_index()
+// The phase-expanded graph has a state 3 * v + ph for v explored in phase ph + 1, and an arc
+// from a state to every state its incoming edges lead to under DSABMScheme. Its SCCs are found
+// with an iterative Tarjan started from the phase-1 states; Tarjan emits every SCC after all
+// SCCs reachable from it, so the slice bitset of an SCC is the union of the tails its states
+// reach and of the bitsets of its successor SCCs. Bitsets of inner SCCs are freed once their
+// last predecessor has used them.
+void ABDG::build_slice_index(){
+    const uint32_t NONE = UINT32_MAX;
+    int states = 3 * n;
+    idx_words = (n + 63) / 64;
+    vector<uint32_t> comp(states, NONE), low(states), order(states, NONE);
+    vector<uint32_t> stack, members;
+    vector<uint32_t> comp_first;      // members[comp_first[c] .. comp_first[c + 1]) are the states of SCC c
+    vector<pair<uint32_t, uint32_t>> call;  // (state, next incoming edge) of the DFS
+    uint32_t counter = 0;
+    for(int root = 0; root < n; root++){
+        if(order[3 * root] != NONE)
+            continue;
+        call.push_back({3 * root, IDL_off[root]});
+        order[3 * root] = low[3 * root] = counter++;
+        stack.push_back(3 * root);
+        while(!call.empty()){
+            uint32_t x = call.back().first, v = x / 3, ph = x % 3;
+            uint32_t& k = call.back().second;
+            if(k < IDL_off[v + 1]){
+                int q = DSABMScheme::next[ph][IDL_type[k]];
+                uint32_t y = 3 * IDL_tail[k] + q - 1;
+                k++;
+                if(q < 1)
+                    continue;
+                if(order[y] == NONE){
+                    order[y] = low[y] = counter++;
+                    stack.push_back(y);
+                    call.push_back({y, IDL_off[y / 3]});
+                }
+                else if(comp[y] == NONE)
+                    low[x] = min(low[x], order[y]);
+                continue;
+            }
+            call.pop_back();
+            if(!call.empty())
+                low[call.back().first] = min(low[call.back().first], low[x]);
+            if(low[x] == order[x]){
+                uint32_t c = comp_first.size();
+                comp_first.push_back(members.size());
+                uint32_t y;
+                do{
+                    y = stack.back();
+                    stack.pop_back();
+                    comp[y] = c;
+                    members.push_back(y);
+                }while(y != x);
+            }
+        }
+    }
+    uint32_t comps = comp_first.size();
+    comp_first.push_back(members.size());
 
-    for(int i = 1; i <= r; i++)
-        V[index++] = "R" + to_string(i);
+    // Uses of every SCC by other SCCs; SCCs of phase-1 states are kept for the index
+    vector<uint32_t> uses(comps, 0);
+    vector<char> keep(comps, 0);
+    for(uint32_t x : members)
+        for(uint32_t k = IDL_off[x / 3]; k < IDL_off[x / 3 + 1]; k++){
+            int q = DSABMScheme::next[x % 3][IDL_type[k]];
+            if(q >= 1 && comp[3 * IDL_tail[k] + q - 1] != comp[x])
+                uses[comp[3 * IDL_tail[k] + q - 1]]++;
+        }
+    for(int v = 0; v < n; v++)
+        keep[comp[3 * v]] = 1;
 
-    for(int i = 1; i <= a; i++)
-        V[index++] = "A" + to_string(i);
+    vector<vector<uint64_t>> bits(comps);
+    for(uint32_t c = 0; c < comps; c++){
+        bits[c].assign(idx_words, 0);
+        for(uint32_t i = comp_first[c]; i < comp_first[c + 1]; i++){
+            uint32_t x = members[i];
+            for(uint32_t k = IDL_off[x / 3]; k < IDL_off[x / 3 + 1]; k++){
+                int q = DSABMScheme::next[x % 3][IDL_type[k]];
+                if(q < 0)
+                    continue;
+                uint32_t u = IDL_tail[k];
+                bits[c][u / 64] |= 1ull << (u % 64);
+                uint32_t d = q >= 1 ? comp[3 * u + q - 1] : c;
+                if(d == c)
+                    continue;
+                for(size_t w = 0; w < idx_words; w++)
+                    bits[c][w] |= bits[d][w];
+                if(--uses[d] == 0 && !keep[d])
+                    vector<uint64_t>().swap(bits[d]);
+            }
+        }
+    }
 
-    for(int i = 1; i <= p; i++)
-        V[index++] = "P" + to_string(i);
+    // One slot per distinct phase-1 SCC
+    vector<uint32_t> slot_of(comps, NONE);
+    idx_slot.assign(n, 0);
+    idx_bits.clear();
+    uint32_t slots = 0;
+    for(int v = 0; v < n; v++){
+        uint32_t c = comp[3 * v];
+        if(slot_of[c] == NONE){
+            slot_of[c] = slots++;
+            idx_bits.insert(idx_bits.end(), bits[c].begin(), bits[c].end());
+        }
+        idx_slot[v] = slot_of[c];
+    }
+}
 
-    for(int i = 1; index < n; i++)
-        V[index++] = "J" + to_string(i);
+// Method definition for graph_checksum()
+uint64_t ABDG::graph_checksum(){
+    // FNV-1a over the vertex counts and the CSR arrays
+    uint64_t h = 14695981039346656037ull;
+    auto mix = [&h](uint64_t x){
+        h ^= x;
+        h *= 1099511628211ull;
+    };
+    mix(n);
+    mix(e);
+    for(int i = 0; i <= n; i++)
+        mix(IDL_off[i]);
+    for(int k = 0; k < e; k++)
+        mix(uint64_t(IDL_tail[k]) << 8 | IDL_type[k]);
+    return h;
 }
 
-// Method definition for index()
-int ABDG::index(const string& v){
-    char type = v[0];
-    int id = stoi(v.substr(1)); // Extract numeric part
+// Index file: "DSABMIDX", version, n, e, graph checksum, number of slots, words per slot,
+// then idx_slot[n] and the slot bitsets
+const char INDEX_MAGIC[8] = {'D', 'S', 'A', 'B', 'M', 'I', 'D', 'X'};
+const uint32_t INDEX_VERSION = 1;
 
-    switch(type){
-        case 'S':
-            return 0;
-        case 'R':
-            return id;
-        case 'A':
-            return r + id;
-        case 'P':
-            return r + a + id;
-        default:
-            return r + a + p + id;
+// Method definition for save_slice_index()
+void ABDG::save_slice_index(const string& index_file){
+    ofstream out(index_file, ios::binary);
+    if(!out.is_open()){
+        cerr << "Error: Could not write index file "<<index_file<<endl;
+        exit(1);
     }
+    uint32_t header[5] = {INDEX_VERSION, uint32_t(n), uint32_t(e), uint32_t(idx_bits.size() / idx_words), uint32_t(idx_words)};
+    uint64_t checksum = graph_checksum();
+    out.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    out.write((const char*)header, sizeof(header));
+    out.write((const char*)&checksum, sizeof(checksum));
+    out.write((const char*)idx_slot.data(), idx_slot.size() * sizeof(uint32_t));
+    out.write((const char*)idx_bits.data(), idx_bits.size() * sizeof(uint64_t));
 }
 
-// Method definition for initialize_dependency_matrix()
-void ABDG::initialize_incident_dependency_list(){
-    vector<pair<string, int>> temp;
-    for(int i = 0; i < n; i++)
-        IDL.push_back(temp);
-    add_edges();
-}
-
-// Method definition for add_edges()
-void ABDG::add_edges(){
-    fs>>e;
-    string tail, head;
-    int edge_type;
-    for(int i = 0; i < e; i++){
-        fs>>tail>>head>>edge_type;
-        IDL[index(head)].push_back({tail, edge_type});
+// Method definition for load_slice_index()
+void ABDG::load_slice_index(const string& index_file){
+    ifstream in(index_file, ios::binary);
+    if(!in.is_open()){
+        cerr << "Error: Could not open index file "<<index_file<<endl;
+        exit(1);
+    }
+    char magic[8];
+    uint32_t header[5];
+    uint64_t checksum;
+    in.read(magic, sizeof(magic));
+    in.read((char*)header, sizeof(header));
+    in.read((char*)&checksum, sizeof(checksum));
+    if(!in || !equal(magic, magic + 8, INDEX_MAGIC) || header[0] != INDEX_VERSION){
+        cerr << "Error: "<<index_file<<" is not a DSABM slice index"<<endl;
+        exit(1);
+    }
+    if(header[1] != uint32_t(n) || header[2] != uint32_t(e) || checksum != graph_checksum()){
+        cerr << "Error: "<<index_file<<" was built for a different ABDG"<<endl;
+        exit(1);
+    }
+    // Everything the lookups index by is checked once here: the words per slot against n, the
+    // slot count against n and the file size, every slot of idx_slot against the slot count, and
+    // the bits past node n - 1 of every slot
+    size_t slots = header[3];
+    idx_words = header[4];
+    if(idx_words != size_t(n + 63) / 64 || slots > size_t(n)){
+        cerr << "Error: "<<index_file<<" is corrupt"<<endl;
+        exit(1);
+    }
+    streamoff data = in.tellg();
+    in.seekg(0, ios::end);
+    uint64_t size = uint64_t(in.tellg() - data);
+    uint64_t expected = uint64_t(n) * sizeof(uint32_t) + uint64_t(slots) * idx_words * sizeof(uint64_t);
+    if(size != expected){
+        cerr << "Error: "<<index_file<<(size < expected ? " is truncated" : " is corrupt")<<endl;
+        exit(1);
+    }
+    in.seekg(data);
+    idx_slot.resize(n);
+    idx_bits.resize(slots * idx_words);
+    in.read((char*)idx_slot.data(), idx_slot.size() * sizeof(uint32_t));
+    in.read((char*)idx_bits.data(), idx_bits.size() * sizeof(uint64_t));
+    if(!in){
+        cerr << "Error: "<<index_file<<" is truncated"<<endl;
+        exit(1);
+    }
+    uint64_t tail_bits = n % 64 ? ~0ull << (n % 64) : 0;
+    bool corrupt = false;
+    for(int v = 0; v < n; v++)
+        corrupt |= idx_slot[v] >= slots;
+    for(size_t c = 0; c < slots; c++)
+        corrupt |= (idx_bits[(c + 1) * idx_words - 1] & tail_bits) != 0;
+    if(corrupt){
+        cerr << "Error: "<<index_file<<" is corrupt"<<endl;
+        exit(1);
     }
 }
 
-// Method definition for DSABM()
-unordered_set<int> ABDG::DSABM(const string& s){
-    unordered_set<int> M1, M2, M3, tempDS;
-    M1.insert(index(s));
-    // Phase 1: Traversal along direct data transactions
-    while(!M1.empty()){
-        auto it = M1.begin();
-        int v = *it;
-        M1.erase(it);
-        for(auto p : IDL[v]){
-            int i = index(p.first);
-            if(tempDS.find(i) == tempDS.end()){
-                tempDS.insert(i);
-                if(p.second == 6 || p.second == 5 || p.second == 4 || p.second == 3)
-                    M1.insert(i);
-                else if(p.second == 2)
-                    M2.insert(i);
-                else
-                    M3.insert(i);
-            }
+// Method definition for indexed_slice()
+void ABDG::indexed_slice(int v, vector<int>& result){
+    result.clear();
+    const uint64_t* bits = &idx_bits[size_t(idx_slot[v]) * idx_words];
+    for(size_t w = 0; w < idx_words; w++)
+        for(uint64_t word = bits[w]; word; word &= word - 1){
+            int u = w * 64 + __builtin_ctzll(word);
+            if(u != v)
+                result.push_back(u);
         }
-    }
-    // Phase 2: Propagation along inter-agent message dependency
-    while(!M2.empty()){
-        auto it = M2.begin();
-        int v = *it;
-        M2.erase(it);
-        for(auto p : IDL[v]){
-            int i = index(p.first);
-            if(tempDS.find(i) == tempDS.end()){
-                tempDS.insert(i);
-                if(p.second == 6 || p.second == 5)
-                    M2.insert(i);
-                else if(p.second == 4 || p.second == 1)
-                    M3.insert(i);
-            }
+}
+
+// Method definition for print_slices()
+// Slices come from the slice index when one is loaded, else from DSABM_multi()
+void ABDG::print_slices(const vector<string>& criteria, const vector<double>& taus, ostream* timing){
+    vector<int> sources;
+    for(size_t first = 0; first < criteria.size(); first += LANES){
+        size_t last = min(criteria.size(), first + LANES);
+        auto start = chrono::steady_clock::now();
+        sources.clear();
+        for(size_t i = first; i < last; i++)
+            sources.push_back(index(criteria[i]));
+        if(idx_slot.empty())
+            DSABM_multi(sources, lanes);
+        else
+            for(size_t i = first; i < last; i++)
+                indexed_slice(sources[i - first], lanes.result[i - first]);
+        if(timing){
+            chrono::duration<double, micro> elapsed = chrono::steady_clock::now() - start;
+            for(size_t i = first; i < last; i++)
+                *timing<<criteria[i]<<" "<<elapsed.count() / (last - first)<<"\n";
         }
-    }
-    // Phase 3: Propagation along control dependency
-    while(!M3.empty()){
-        auto it = M3.begin();
-        int v = *it;
-        M3.erase(it);
-        for(auto p : IDL[v]){
-            int i = index(p.first);
-            if(tempDS.find(i) == tempDS.end()){
-                if(p.second == 6 || p.second == 5 || p.second == 3){
-                    M3.insert(i);
-                    tempDS.insert(i);
-                }
-            }
+        for(size_t i = first; i < last; i++){
+            const vector<int>& result = lanes.result[i - first];
+            cout<<criteria[i]<<" "<<taus[i]<<" dsabm "<<result.size()<<" :";
+            for(auto v : result)
+                cout<<" "<<V[v];
+            cout<<"\n";
         }
     }
-    auto it = tempDS.find(index(s));
-    if(it != tempDS.end())
-        tempDS.erase(it);
-    return tempDS;
+    cout.flush();
 }
 
-// Constructor Definition
-ABDG::ABDG(){
-    fs.open("input_file.txt", ios::in);
-    if(!fs.is_open()){
-        cerr << "Error: Could not open input file "<<endl;
+// Method definition for read_queries()
+void ABDG::read_queries(const string& query_file, vector<string>& criteria, vector<double>& taus){
+    ifstream qs(query_file);
+    if(!qs.is_open()){
+        cerr << "Error: Could not open query file "<<query_file<<endl;
         exit(1);
     }
-    fs>>n;
-    V = new string[n];
-    for(int i = 0; i < n; i++){
-        fs>>V[i];
+    string line, s, mode;
+    double tau;
+    while(getline(qs, line)){
+        istringstream ls(line);
+        if(!(ls>>s) || s[0] == '#')
+            continue;
+        if(!(ls>>tau>>mode)){
+            cerr<<"Error: Malformed query: "<<line<<endl;
+            continue;
+        }
+        if(index(s) < 0){
+            cerr<<"Error: Unknown slice criterion "<<s<<endl;
+            continue;
+        }
+        if(mode != "dsabm"){
+            cerr<<"Error: Unsupported mode "<<mode<<" (expected dsabm)"<<endl;
+            continue;
+        }
+        criteria.push_back(s);
+        taus.push_back(tau);
+    }
+}
+
+// Method definition for run_batch()
+void ABDG::run_batch(const string& query_file, ostream* timing){
+    vector<string> criteria;
+    vector<double> taus;
+    read_queries(query_file, criteria, taus);
+    print_slices(criteria, taus, timing);
+}
+
+// Method definition for run_bench()
+void ABDG::run_bench(const string& query_file, const BenchConfig& config){
+    vector<string> criteria;
+    vector<double> taus;
+    read_queries(query_file, criteria, taus);
+    PerfCounters counters;
+    print_bench_header(cout, config, pin_thread(config.cpu), counters);
+    vector<BenchResult> results;
+    for(const string& s : criteria){
+        vector<int> source(1, index(s));
+        results.push_back(bench([&]{
+            if(idx_slot.empty())
+                DSABM_multi(source, lanes);
+            else
+                indexed_slice(source[0], lanes.result[0]);
+        }, config, counters));
+        print_bench_result(cout, s, results.back());
     }
-    update_r_a_p();
-    sort_V();
-    initialize_incident_dependency_list();
+    print_bench_summary(cout, results);
+    cout.flush();
 }
 
-// Destructor Definition
-ABDG::~ABDG(){
+// Method definition for run_all()
+void ABDG::run_all(){
+    print_slices(V, vector<double>(n, 0.0));
+}
+
+// Constructor Definition
+ABDG::ABDG(const string& file) : ws(0, 1){
+    SliceGraph G;
+    G.load(file);
+    build(G);
     for(int i = 0; i < n; i++)
-        delete &IDL[i];
-    IDL.clear();
-    delete[] V;
+        V.push_back(node_name(i));
+    ws = make_scratch();
 }
 
-int main(){
-    unsigned int t;
-    ABDG G;
+int main(int argc, char *argv[]){
+    string graph_file = "input_file.txt", build_file, index_file, timing_file;
+    BenchConfig config;
+    bool bench_mode = false;
+    int arg = 1;
+    for(; arg + 1 < argc && argv[arg][0] == '-' && string(argv[arg]) != "-a"; arg += 2){
+        string option = argv[arg];
+        if(option == "-g")
+            graph_file = argv[arg + 1];
+        else if(option == "-b")
+            build_file = argv[arg + 1];
+        else if(option == "-i")
+            index_file = argv[arg + 1];
+        else if(option == "-p")
+            timing_file = argv[arg + 1];
+        else if(option == "-n"){
+            config.iterations = atoi(argv[arg + 1]);
+            bench_mode = true;
+        }
+        else if(option == "-w")
+            config.warmup = atoi(argv[arg + 1]);
+        else if(option == "-k")
+            config.cpu = atoi(argv[arg + 1]);
+        else
+            break;
+    }
+    auto start = chrono::steady_clock::now();
+    ABDG G(graph_file);
+    // Timing record: load time first, then one line per query (criterion microseconds)
+    ofstream timing;
+    if(!timing_file.empty()){
+        timing.open(timing_file);
+        if(!timing.is_open()){
+            cerr << "Error: Could not open timing file "<<timing_file<<endl;
+            exit(1);
+        }
+        timing<<"load "<<chrono::duration<double, micro>(chrono::steady_clock::now() - start).count()<<"\n";
+    }
+    // Offline indexing: precompute and save the slices of all criteria
+    if(!build_file.empty()){
+        G.build_slice_index();
+        G.save_slice_index(build_file);
+        if(arg == argc)
+            return 0;
+    }
+    else if(!index_file.empty())
+        G.load_slice_index(index_file);
+    // Slices of every node, LANES criteria per traversal
+    if(arg < argc && string(argv[arg]) == "-a"){
+        ios::sync_with_stdio(false);
+        G.run_all();
+        return 0;
+    }
+    // Benchmark mode: latency statistics of every query of the given file
+    if(arg < argc && bench_mode){
+        G.run_bench(argv[arg], config);
+        return 0;
+    }
+    // Batch mode: answer every query of the given file against the same ABDG
+    if(arg < argc){
+        ios::sync_with_stdio(false);
+        G.run_batch(argv[arg], timing.is_open() ? &timing : nullptr);
+        return 0;
+    }
     // G.show_vertices();
     // G.show_incident_dependency_list();
     // cout<<"Enter the number of slice criterions: ";
     // cin>>t;
     // while(t--)
     G.display_dynamic_slice();
-    // system("pause");
-    _getch();
     return 0;
 }
\ No newline at end of file
@@ -15,10 +15,22 @@ Input: 1. Agent Behavior Dependency Graph (ABDG)
         2. Slice Criterion
         - Number of slice criterions, t (positive integer)
         - Slice criterion for each iteration over t, s. s belong to V
+        3. Batch Query File (optional, path given as the first command-line argument)
+        - One query per line in the format: criterion <space> tau <space> mode
+                - criterion belongs to V
+                - tau is a threshold in [0, 1] (ignored by the unweighted DSABM)
+                - mode is dsabm (pruned queries are answered by dsabm_integrated)
+        - Lines starting with # are ignored
+        4. Options: -g graph_file (default input_file.txt), -b backend among matrix, list and
+           weighted (default weighted, the Incident-Dependency List in CSR form; see dsabm_slicer.h),
+           -w warmup runs (default 10), -n timed iterations (default 100), -k cpu to pin to
+           (default 0, -1 for no pinning)
 Output: 1. A list of vertex with their index as prefix
         2. Incedent-Dependency List of |V| vector entries, each representing a vertex Vi
         - Each vector contains the tail, u of incident edges u -> Vi (of which Vi is a head) and their nature (an integer from [1-6] as per the above-mentioned notation)
         3. Dynamic slice as computed using Dynamic Slicing algorithm for Agent Behavior Model (DSABM) corresponding each slice criterion
+        4. In batch mode, one line per query with its latency over the timed iterations (see
+           bench_harness.h): criterion min median p99 ci95_low ci95_high cycles cache_misses branch_misses
 Author: Jibesh Kumar Panda
         - Version 1.2
         - Date: 11.01.2025
@@ -28,58 +40,41 @@ Author: Jibesh Kumar Panda
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <sstream>
 #include <vector>
-#include <unordered_set>
-#include <array>
 #include <string>
+#include <memory>
+#include <cstdint>
 // #include <cstdlib>
-#include <conio.h>
 #include <ctime>
 #include <chrono>
 using namespace std;
+#include "bench_harness.h"
+#include "dsabm_slicer.h"
 
 class ABDG{
-        // Number of Vertices (For initialization of Graph Representation)
-        int n;
-        // Set of Vertices
-        string *V;
-        // Number of Edges
-        int e;
-        // Number of rule nodes, activity nodes, and procedure nodes
-        int r, a, p;
-        // Incident-Dependency List
-        vector<vector<pair<string, int>>> IDL;
-        // To be computed internally
-        void update_r_a_p();
-        // Method to sort the nodes
-        void sort_V();
-        // Method to map a node to index
-        int index(const string&);
-        // Method to initialize dependency matrix
-        void initialize_incident_dependency_list();
-        // Method to add dependencies
-        void add_edges();
-        // Method to compute Dynamic Slice (Implementation of DSABM)
-        unordered_set<int> DSABM(const string& s);
-        // File Stream
-        fstream fs;
+        // Vertices, Edges and node numbering
+        SliceGraph G;
+        // Backend computing the Dynamic Slice (Implementation of DSABM)
+        unique_ptr<Slicer> slicer;
+        // Incident-Dependency List of the display, as (tail, edge_type) pairs per vertex
+        ListSlicer IDL;
     public:
         // Constructor
-        ABDG();
-        // Destructor
-        ~ABDG();
+        ABDG(const string& file = "input_file.txt", const string& backend = "weighted");
         // Method to show all vertices
         void show_vertices(){
-            for(int i = 0; i < n - 1; i++)
-                cout<<index(V[i])<<":"<<V[i]<<", ";
-            cout<<index(V[n - 1])<<":"<<V[n - 1]<<endl;
+            for(int i = 0; i < G.n - 1; i++)
+                cout<<i<<":"<<G.node_name(i)<<", ";
+            cout<<G.n - 1<<":"<<G.node_name(G.n - 1)<<endl;
         }
         // Method to show dependency matrix
         void show_incident_dependency_list(){
-            for(int i = 0; i < n; i++){
-                cout<<V[i]<<": ";
-                for(auto p : IDL[i])
-                    cout<<"- "<<p.first<<"|"<<p.second<<" ";
+            IDL.build(G);
+            for(int i = 0; i < G.n; i++){
+                cout<<G.node_name(i)<<": ";
+                for(auto p : IDL.incident(i))
+                    cout<<"- "<<G.node_name(p.first)<<"|"<<p.second<<" ";
                 cout<<endl;
             }
         }
@@ -88,187 +83,106 @@ class ABDG{
             string s;
             cout<<"Enter the slice criterion (node): ";
             cin>>s;
-            // clock_t start = clock();
-            auto start = chrono::high_resolution_clock::now();
-            unordered_set<int> tempDS = DSABM(s);
-            auto stop = chrono::high_resolution_clock::now();
-            // clock_t end = clock();
-            // double elapsed = double(end - start) / CLOCKS_PER_SEC; // Convert to seconds
+            int start = G.index(s);
+            if(start < 0){
+                cerr<<"Error: Unknown slice criterion "<<s<<endl;
+                return;
+            }
+            BenchConfig config;
+            PerfCounters counters;
+            pin_thread(config.cpu);
+            BenchResult timing = bench([&]{ slicer->DSABM(start); }, config, counters);
+            const vector<int>& tempDS = slicer->DSABM(start);
             if(tempDS.size())
                 cout<<"Dynamic Slice Set corresponding criterion "<<s<<" is:"<<endl;
             for(auto v : tempDS)
-                cout<<V[v]<<" ";
-            auto duration = chrono::duration_cast<chrono::microseconds>(stop - start);
-            cout << endl << "Average Slicing Time: " << duration.count() << " microseconds";
-            // cout << endl<< "Average Slicing Time: " << elapsed << " seconds";
+                cout<<G.node_name(v)<<" ";
+            cout << endl << "Median Slicing Time: " << timing.median << " microseconds (min " << timing.min
+                 << ", p99 " << timing.p99 << ", over " << config.iterations << " runs)";
             cout<<endl;
         }
+        // Method to benchmark every query of a batch query file
+        void run_batch(const string& query_file, const BenchConfig& config);
 };
 
-// Method definition for update_r_a_p()
-void ABDG::update_r_a_p(){
-    r = a = p = 0;
-    for(int i = 0; i < n; i++){
-        if(V[i][0] == 'R')
-            r++;
-        else if(V[i][0] == 'A')
-            a++;
-        else if(V[i][0] == 'P')
-            p++;
-    }
-}
-
-// Method definition for sort_V()
-void ABDG::sort_V(){
-    V[0] = "S0";
-    int index = 1;
-
-    for(int i = 1; i <= r; i++)
-        V[index++] = "R" + to_string(i);
-
-    for(int i = 1; i <= a; i++)
-        V[index++] = "A" + to_string(i);
-
-    for(int i = 1; i <= p; i++)
-        V[index++] = "P" + to_string(i);
-
-    for(int i = 1; index < n; i++)
-        V[index++] = "J" + to_string(i);
-}
-
-// Method definition for index()
-int ABDG::index(const string& v){
-    char type = v[0];
-    int id = stoi(v.substr(1)); // Extract numeric part
-
-    switch(type){
-        case 'S':
-            return 0;
-        case 'R':
-            return id;
-        case 'A':
-            return r + id;
-        case 'P':
-            return r + a + id;
-        default:
-            return r + a + p + id;
-    }
-}
-
-// Method definition for initialize_dependency_matrix()
-void ABDG::initialize_incident_dependency_list(){
-    vector<pair<string, int>> temp;
-    for(int i = 0; i < n; i++)
-        IDL.push_back(temp);
-    add_edges();
-}
-
-// Method definition for add_edges()
-void ABDG::add_edges(){
-    fs>>e;
-    string tail, head;
-    int edge_type;
-    for(int i = 0; i < e; i++){
-        fs>>tail>>head>>edge_type;
-        IDL[index(head)].push_back({tail, edge_type});
+// Method definition for run_batch()
+void ABDG::run_batch(const string& query_file, const BenchConfig& config){
+    ifstream qs(query_file);
+    if(!qs.is_open()){
+        cerr << "Error: Could not open query file "<<query_file<<endl;
+        exit(1);
     }
-}
-
-// Method definition for DSABM()
-unordered_set<int> ABDG::DSABM(const string& s){
-    unordered_set<int> M1, M2, M3, tempDS;
-    M1.insert(index(s));
-    for(volatile int i = 0; i < 1000000; i++);
-    // Phase 1: Traversal along direct data transactions
-    while(!M1.empty()){
-        auto it = M1.begin();
-        int v = *it;
-        M1.erase(it);
-        for(auto p : IDL[v]){
-            int i = index(p.first);
-            if(tempDS.find(i) == tempDS.end()){
-                tempDS.insert(i);
-                if(p.second == 6 || p.second == 5 || p.second == 4 || p.second == 3)
-                    M1.insert(i);
-                else if(p.second == 2)
-                    M2.insert(i);
-                else
-                    M3.insert(i);
-            }
+    string line, s, mode;
+    double tau;
+    int start;
+    PerfCounters counters;
+    print_bench_header(cout, config, pin_thread(config.cpu), counters);
+    vector<BenchResult> results;
+    while(getline(qs, line)){
+        istringstream ls(line);
+        if(!(ls>>s) || s[0] == '#')
+            continue;
+        if(!(ls>>tau>>mode)){
+            cerr<<"Error: Malformed query: "<<line<<endl;
+            continue;
         }
-    }
-    // Phase 2: Propagation along inter-agent message dependency
-    while(!M2.empty()){
-        auto it = M2.begin();
-        int v = *it;
-        M2.erase(it);
-        for(auto p : IDL[v]){
-            int i = index(p.first);
-            if(tempDS.find(i) == tempDS.end()){
-                tempDS.insert(i);
-                if(p.second == 6 || p.second == 5)
-                    M2.insert(i);
-                else if(p.second == 4 || p.second == 1)
-                    M3.insert(i);
-            }
+        if((start = G.index(s)) < 0){
+            cerr<<"Error: Unknown slice criterion "<<s<<endl;
+            continue;
         }
-    }
-    // Phase 3: Propagation along control dependency
-    while(!M3.empty()){
-        auto it = M3.begin();
-        int v = *it;
-        M3.erase(it);
-        for(auto p : IDL[v]){
-            int i = index(p.first);
-            if(tempDS.find(i) == tempDS.end()){
-                if(p.second == 6 || p.second == 5 || p.second == 3){
-                    M3.insert(i);
-                    tempDS.insert(i);
-                }
-            }
+        if(mode != "dsabm"){
+            cerr<<"Error: Unsupported mode "<<mode<<" (expected dsabm)"<<endl;
+            continue;
         }
+        results.push_back(bench([&]{ slicer->DSABM(start); }, config, counters));
+        print_bench_result(cout, s, results.back());
     }
-    auto it = tempDS.find(index(s));
-    if(it != tempDS.end())
-        tempDS.erase(it);
-    return tempDS;
+    print_bench_summary(cout, results);
+    cout.flush();
 }
 
 // Constructor Definition
-ABDG::ABDG(){
-    fs.open("input_file.txt", ios::in);
-    if(!fs.is_open()){
-        cerr << "Error: Could not open input file "<<endl;
+ABDG::ABDG(const string& file, const string& backend){
+    slicer = make_slicer(backend);
+    if(!slicer){
+        cerr<<"Error: Unknown backend "<<backend<<" (expected matrix, list or weighted)"<<endl;
         exit(1);
     }
-    fs>>n;
-    V = new string[n];
-    for(int i = 0; i < n; i++){
-        fs>>V[i];
-    }
-    update_r_a_p();
-    sort_V();
-    initialize_incident_dependency_list();
+    G.load(file);
+    slicer->build(G);
 }
 
-// Destructor Definition
-ABDG::~ABDG(){
-    for(int i = 0; i < n; i++)
-        delete &IDL[i];
-    IDL.clear();
-    delete[] V;
-}
-
-int main(){
-    unsigned int t;
-    ABDG G;
+int main(int argc, char *argv[]){
+    string graph_file = "input_file.txt", backend = "weighted";
+    BenchConfig config;
+    int arg = 1;
+    for(; arg + 1 < argc && argv[arg][0] == '-'; arg += 2){
+        string option = argv[arg];
+        if(option == "-g")
+            graph_file = argv[arg + 1];
+        else if(option == "-b")
+            backend = argv[arg + 1];
+        else if(option == "-w")
+            config.warmup = atoi(argv[arg + 1]);
+        else if(option == "-n")
+            config.iterations = atoi(argv[arg + 1]);
+        else if(option == "-k")
+            config.cpu = atoi(argv[arg + 1]);
+        else
+            break;
+    }
+    ABDG G(graph_file, backend);
+    // Batch mode: benchmark every query of the given file against the same ABDG
+    if(arg < argc){
+        ios::sync_with_stdio(false);
+        G.run_batch(argv[arg], config);
+        return 0;
+    }
     // G.show_vertices();
     // G.show_incident_dependency_list();
     // cout<<"Enter the number of slice criterions: ";
     // cin>>t;
     // while(t--)
     G.display_dynamic_slice();
-    // system("pause");
-    _getch();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,112 @@
+/*
+Phase automaton of DSABM, shared by the slicers
+        - A phase scheme is a struct holding the number of phases and two constexpr tables:
+                - next[phase - 1][edge_type]: the phase (1..PHASES) in which the tail of an edge
+                  is explored when the edge is followed from the given phase, 0 if the tail only
+                  joins the slice, -1 if the edge is not followed
+                - weight[edge_type]: the relevance an edge keeps when it is followed
+        - Column 0 of next stands for "no edge" and rejects in every phase, so a dependency matrix
+          cell can index the table directly
+        - Traversal kernels take the scheme as a template parameter: the tables are compile-time
+          constants of the kernel, and every per-edge decision is a lookup instead of a chain of
+          comparisons. A new dependency type or phase scheme is a new table, not a new kernel.
+*/
+
+#ifndef DSABM_PHASES_H
+#define DSABM_PHASES_H
+
+#include <cstdint>
+#include <cstddef>
+
+// Edge types 1-6 (see the input format), plus 0 for "no edge"
+const int EDGE_TYPES = 7;
+
+// Every DSABM traversal explores each (node, phase) state at most once, and a node joins the
+// slice when an edge into it is followed (next >= 0); the criterion itself is not part of it.
+// A node reached again in another phase is explored in that phase too, since the edges it
+// follows depend on the phase: the slice is the set of tails reachable in the phase-expanded
+// graph, whatever the order in which the worklists are drained, so every slicer returns the
+// same one. (The first slicers marked nodes instead of states, so a node was only explored in
+// the phase that reached it first, and their slices depended on the visiting order.)
+
+// The three phases of DSABM
+//        - Phase 1: Traversal along direct data transactions (types 6, 5, 4, 3 stay, 2 moves to
+//          phase 2, 1 to phase 3)
+//        - Phase 2: Propagation along inter-agent message dependency (types 6, 5 stay, 4 and 1
+//          move to phase 3, the tails of 3 and 2 only join the slice)
+//        - Phase 3: Propagation along control dependency (types 6, 5, 3 stay, the rest is cut)
+struct DSABMScheme{
+    static const int PHASES = 3;
+    static constexpr int8_t next[PHASES][EDGE_TYPES] = {
+        {-1, 3, 2, 1, 1, 1, 1},
+        {-1, 3, 0, 0, 3, 2, 2},
+        {-1, -1, -1, 3, -1, 3, 3}
+    };
+    static constexpr double weight[EDGE_TYPES] = {0.0, 0.1, 0.3, 0.5, 0.7, 0.9, 1.0};
+};
+#if __cplusplus < 201703L
+// Before C++17 the tables also need a definition outside the class
+constexpr int8_t DSABMScheme::next[DSABMScheme::PHASES][EDGE_TYPES];
+constexpr double DSABMScheme::weight[EDGE_TYPES];
+#endif
+
+// Weight of an edge of the given type followed from the given phase, 0 if it is not followed
+template <class Scheme>
+constexpr double follow_weight(int phase, int type){
+    return Scheme::next[phase - 1][type] < 0 ? 0.0 : Scheme::weight[type];
+}
+
+// True if no transition of the scheme leads back to an earlier phase, so that a kernel may
+// drain the phases one after the other. Checks the cells from (phase, type) on, recursively:
+// a C++11 constexpr function is a single return statement.
+template <class Scheme>
+constexpr bool forward_only(int phase = 1, int type = 0){
+    return phase > Scheme::PHASES ? true
+         : type == EDGE_TYPES ? forward_only<Scheme>(phase + 1, 0)
+         : !(Scheme::next[phase - 1][type] > 0 && Scheme::next[phase - 1][type] < phase) &&
+           forward_only<Scheme>(phase, type + 1);
+}
+
+// Forward (impact) automaton of a phase scheme: the backward traversal run in reverse, so that w
+// is in the forward slice of x exactly when x is in the (backward) slice of w. A forward state
+// (v, ph) stands for "v is explored in phase ph by the backward traversal of some criterion".
+//        - start[type]: phases (bit ph - 1) in which the backward traversal may follow an edge of
+//          that type, i.e. in which the head of an out-edge of x may be explored
+//        - from[ph - 1][type]: phases whose edges of that type lead to phase ph; the forward state
+//          (v, ph) moves along an out-edge v -> w to (w, ph') for every phase ph' of the mask
+//        - w belongs to the forward slice once (w, 1) is reached: w, as a criterion, starts there
+template <class Scheme>
+struct ForwardScheme{
+    uint8_t start[EDGE_TYPES];
+    uint8_t from[Scheme::PHASES][EDGE_TYPES];
+    ForwardScheme(){
+        for(int type = 0; type < EDGE_TYPES; type++){
+            start[type] = 0;
+            for(int ph = 1; ph <= Scheme::PHASES; ph++)
+                from[ph - 1][type] = 0;
+            for(int ph = 1; ph <= Scheme::PHASES; ph++){
+                int q = Scheme::next[ph - 1][type];
+                if(q >= 0)
+                    start[type] |= 1 << (ph - 1);
+                if(q > 0)
+                    from[q - 1][type] |= 1 << (ph - 1);
+            }
+        }
+    }
+};
+
+// Fingerprint of a phase scheme (FNV-1a over its tables): results computed under one scheme can
+// be told apart from those of another, e.g. in a cache
+template <class Scheme>
+inline uint64_t scheme_fingerprint(){
+    uint64_t h = 14695981039346656037ull;
+    auto mix = [&h](const void* data, size_t size){
+        for(size_t i = 0; i < size; i++)
+            h = (h ^ static_cast<const unsigned char*>(data)[i]) * 1099511628211ull;
+    };
+    mix(Scheme::next, sizeof(Scheme::next));
+    mix(Scheme::weight, sizeof(Scheme::weight));
+    return h;
+}
+
+#endif
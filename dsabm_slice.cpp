@@ -0,0 +1,224 @@
+/*
+Input: 1. Agent Behavior Dependency Graph (ABDG), in the input format of the slicers
+        2. Batch Query File (path given as the last command-line argument)
+        - One query per line in the format: criterion <space> tau <space> mode
+                - criterion belongs to V
+                - tau is a threshold in [0, 1] (ignored by the unweighted DSABM)
+                - mode belongs to {dsabm, pruned}; pruned queries are skipped (and counted) on the
+                  backends that are not weighted
+        - Lines starting with # are ignored
+        3. Options: -b backends, comma-separated among matrix, list and weighted (default weighted;
+           see dsabm_slicer.h), -g graph_file (default input_file.txt), -p timing_file to record
+           the load time and the latency of every query (in microseconds, first backend),
+           -n iterations to benchmark every query instead (see bench_harness.h), with -w warmup
+           runs on cpu -k
+Output: 1. One backend: one line per query, criterion tau mode |slice| : slice (nodes in index order)
+        2. Several backends: the same query set is run against each of them, then one row per
+           backend: load time, queries answered and skipped, mean and max latency, and the
+           queries whose slice differs from the one of the first backend answering them
+        3. With -n, the bench_harness.h report of every query on every backend
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <algorithm>
+#include <chrono>
+#include "bench_harness.h"
+#include "dsabm_slicer.h"
+using namespace std;
+
+// Slice query of a batch file, with the index of its criterion
+struct SliceQuery{
+    string criterion;
+    double tau;
+    string mode;
+    int node;
+};
+
+// Method to read the queries of a batch file
+vector<SliceQuery> read_queries(const string& query_file, const SliceGraph& G){
+    ifstream qs(query_file);
+    if(!qs.is_open()){
+        cerr<<"Error: Could not open query file "<<query_file<<endl;
+        exit(1);
+    }
+    vector<SliceQuery> queries;
+    string line;
+    SliceQuery q;
+    while(getline(qs, line)){
+        istringstream ls(line);
+        if(!(ls>>q.criterion) || q.criterion[0] == '#')
+            continue;
+        if(!(ls>>q.tau>>q.mode)){
+            cerr<<"Error: Malformed query: "<<line<<endl;
+            continue;
+        }
+        if((q.node = G.index(q.criterion)) < 0){
+            cerr<<"Error: Unknown slice criterion "<<q.criterion<<endl;
+            continue;
+        }
+        if(q.mode != "dsabm" && q.mode != "pruned"){
+            cerr<<"Error: Unsupported mode "<<q.mode<<" (expected dsabm or pruned)"<<endl;
+            continue;
+        }
+        queries.push_back(q);
+    }
+    return queries;
+}
+
+// Method to check whether a backend answers a query
+bool answers(const Slicer& S, const SliceQuery& q){
+    return q.mode == "dsabm" || S.weighted();
+}
+
+// Method to answer one query
+const vector<int>& slice(Slicer& S, const SliceQuery& q){
+    return q.mode == "dsabm" ? S.DSABM(q.node) : S.DSABM_Integrated(q.node, q.tau);
+}
+
+int main(int argc, char *argv[]){
+    string graph_file = "input_file.txt", backend_list = "weighted", timing_file;
+    BenchConfig config;
+    bool bench_mode = false;
+    int arg = 1;
+    const string options[] = {"-b", "-g", "-p", "-n", "-w", "-k"};
+    while(arg + 1 < argc && find(begin(options), end(options), argv[arg]) != end(options)){
+        string option = argv[arg];
+        if(option == "-b")
+            backend_list = argv[arg + 1];
+        else if(option == "-g")
+            graph_file = argv[arg + 1];
+        else if(option == "-p")
+            timing_file = argv[arg + 1];
+        else if(option == "-n")
+            config.iterations = atoi(argv[arg + 1]), bench_mode = true;
+        else if(option == "-w")
+            config.warmup = atoi(argv[arg + 1]);
+        else
+            config.cpu = atoi(argv[arg + 1]);
+        arg += 2;
+    }
+    if(arg + 1 != argc){
+        cerr<<"Usage: "<<argv[0]<<" [-b backends] [-g graph_file] [-p timing_file] [-n iterations -w warmup -k cpu] query_file"<<endl;
+        exit(1);
+    }
+
+    vector<unique_ptr<Slicer>> backends;
+    istringstream bs(backend_list);
+    string name;
+    while(getline(bs, name, ',')){
+        backends.push_back(make_slicer(name));
+        if(!backends.back()){
+            cerr<<"Error: Unknown backend "<<name<<" (expected matrix, list or weighted)"<<endl;
+            exit(1);
+        }
+    }
+    if(backends.empty()){
+        cerr<<"Error: No backend given"<<endl;
+        exit(1);
+    }
+
+    auto start = chrono::steady_clock::now();
+    SliceGraph G;
+    G.load(graph_file);
+    double parse = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+    vector<SliceQuery> queries = read_queries(argv[arg], G);
+    for(auto& S : backends){
+        size_t skipped = 0;
+        for(const SliceQuery& q : queries)
+            skipped += !answers(*S, q);
+        if(skipped)
+            cerr<<"Error: Backend "<<S->name()<<" does not answer pruned queries, "<<skipped<<" skipped"<<endl;
+    }
+
+    ios::sync_with_stdio(false);
+    ofstream timing;
+    if(!timing_file.empty()){
+        timing.open(timing_file);
+        if(!timing.is_open()){
+            cerr<<"Error: Could not open timing file "<<timing_file<<endl;
+            exit(1);
+        }
+    }
+    PerfCounters counters;
+    if(bench_mode)
+        print_bench_header(cout, config, pin_thread(config.cpu), counters);
+
+    // Slices of the first backend answering every query (sorted), the reference of the others
+    vector<vector<int>> reference(queries.size());
+    vector<bool> answered(queries.size(), false);
+    vector<int> sorted;
+    for(size_t b = 0; b < backends.size(); b++){
+        Slicer& S = *backends[b];
+        // Every backend is charged the parse of the file plus its own build
+        start = chrono::steady_clock::now();
+        S.build(G);
+        double load = parse + chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+        if(b == 0 && timing.is_open())
+            timing<<"load "<<load<<"\n";
+
+        if(bench_mode){
+            vector<BenchResult> results;
+            for(const SliceQuery& q : queries){
+                if(!answers(S, q))
+                    continue;
+                results.push_back(bench([&]{ slice(S, q); }, config, counters));
+                ostringstream label;
+                label<<S.name()<<"/"<<q.criterion<<"/"<<q.mode<<"/"<<q.tau;
+                print_bench_result(cout, label.str(), results.back());
+            }
+            print_bench_summary(cout, results);
+            continue;
+        }
+
+        double total = 0, worst = 0;
+        size_t mismatches = 0, skipped = 0;
+        for(size_t i = 0; i < queries.size(); i++){
+            const SliceQuery& q = queries[i];
+            if(!answers(S, q)){
+                skipped++;
+                continue;
+            }
+            auto begin = chrono::steady_clock::now();
+            const vector<int>& result = slice(S, q);
+            double elapsed = chrono::duration<double, micro>(chrono::steady_clock::now() - begin).count();
+            total += elapsed;
+            worst = max(worst, elapsed);
+            if(b == 0 && timing.is_open())
+                timing<<q.criterion<<" "<<elapsed<<"\n";
+            sorted.assign(result.begin(), result.end());
+            sort(sorted.begin(), sorted.end());
+            if(!answered[i]){
+                reference[i] = sorted;
+                answered[i] = true;
+            }
+            else if(sorted != reference[i])
+                mismatches++;
+            if(backends.size() == 1){
+                cout<<q.criterion<<" "<<q.tau<<" "<<q.mode<<" "<<sorted.size()<<" :";
+                for(int v : sorted)
+                    cout<<" "<<G.node_name(v);
+                cout<<"\n";
+            }
+        }
+        if(backends.size() > 1){
+            if(b == 0){
+                cout<<left<<setw(10)<<"Backend"<<" | "<<right<<setw(10)<<"Load (ms)"<<" | "<<setw(7)<<"Queries"<<" | "
+                    <<setw(7)<<"Skipped"<<" | "<<setw(10)<<"Mean (us)"<<" | "<<setw(10)<<"Max (us)"<<" | "<<setw(10)<<"Mismatches"<<"\n";
+                cout<<string(82, '-')<<"\n";
+            }
+            size_t count = queries.size() - skipped;
+            cout<<left<<setw(10)<<S.name()<<" | "<<right<<fixed<<setprecision(2)<<setw(10)<<load / 1000<<" | "
+                <<setw(7)<<count<<" | "<<setw(7)<<skipped<<" | "<<setw(10)<<total / max<size_t>(1, count)<<" | "
+                <<setw(10)<<worst<<" | "<<setw(10)<<mismatches<<"\n";
+            cout.unsetf(ios::floatfield);
+        }
+    }
+    cout.flush();
+    return 0;
+}
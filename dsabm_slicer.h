@@ -0,0 +1,1318 @@
+/*
+Slicing library shared by the DSABM backends
+        - SliceNumbering: the node numbering of sort_V(), S0, R1..Rr, A1..Aa, P1..Pp, J1..
+        - SliceGraph: an ABDG read from the input format of the slicers (Number of Vertices, n;
+          Vertices; Number of Edges, e; Edges as tail <space> head <space> edge_type)
+        - SliceCSR: the Incident-Dependency List in CSR form and its transpose, with the slicing
+          kernels of dsabm_integrated and dsabm_list_fin on them (DSABM, best-first relevance
+          propagation, relevance profile, top-k, forward slice, chop, weight sensitivity and the
+          bit-parallel multi-criteria DSABM, LaneScratch<WORDS> answering 64 * WORDS criteria
+          per traversal); their per-thread buffers are SliceScratch, SensitivityScratch and
+          LaneScratch
+        - Slicer: the common interface of a backend. A backend is built once from a SliceGraph and
+          owns its traversal buffers, so one instance answers the queries of one thread.
+                - DSABM(s): Dynamic Slice of criterion s (node index), nodes in any order
+                - DSABM_Integrated(s, tau): relevance-pruned slice, for the backends with weighted()
+        - Backends, chosen at runtime by name (make_slicer()):
+                - matrix: bit-packed column-major dependency matrix, O(n^2) memory (the engine of
+                  dsabm_dg, dsabm_dg_2 and dsabm_dg_3)
+                - list: Incident-Dependency List of per-node vectors (the engine of dsabm_list)
+                - weighted: a SliceCSR, with the DSABM and the best-first relevance propagation of
+                  dsabm_integrated; the only backend answering pruned queries
+          dsabm_list_fin_time and the dsabm_slice driver take any of them
+        - Every backend explores a node at most once per phase (see dsabm_phases.h), so all of them
+          return the same slices, parallel edges of different types included
+*/
+
+#ifndef DSABM_SLICER_H
+#define DSABM_SLICER_H
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <queue>
+#include <utility>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <functional>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include "dsabm_phases.h"
+
+// Names of the backends of make_slicer()
+const char* const SLICER_NAMES[] = {"matrix", "list", "weighted"};
+
+// Node numbering of an ABDG, as sort_V() does: S0, R1..Rr, A1..Aa, P1..Pp, J1..
+class SliceNumbering{
+    public:
+        // Number of vertices, and of rule, activity and procedure nodes
+        int n = 0, r = 0, a = 0, p = 0;
+        // Method to map the node [b, e) to index, -1 if it is not a node of the graph; the id is
+        // read without a throwing conversion, so a name of any length is answered
+        int index(const char* b, const char* e) const{
+            if(e - b < 2 || e - b > 20)
+                return -1;
+            uint64_t id = 0;
+            for(const char* c = b + 1; c < e; c++){
+                if(*c < '0' || *c > '9')
+                    return -1;
+                id = id * 10 + (*c - '0');
+            }
+            switch(*b){
+                case 'S':
+                    return id == 0 ? 0 : -1;
+                case 'R':
+                    return id >= 1 && id <= uint64_t(r) ? int(id) : -1;
+                case 'A':
+                    return id >= 1 && id <= uint64_t(a) ? int(r + id) : -1;
+                case 'P':
+                    return id >= 1 && id <= uint64_t(p) ? int(r + a + id) : -1;
+                case 'J':
+                    return id >= 1 && id < uint64_t(n - r - a - p) ? int(r + a + p + id) : -1;
+                default:
+                    return -1;
+            }
+        }
+        // Method to map a node to index, -1 if it is not a node of the graph
+        int index(const std::string& v) const{
+            return index(v.data(), v.data() + v.size());
+        }
+        // Method to map an index to its node
+        std::string node_name(int i) const{
+            if(i == 0)
+                return "S0";
+            if(i <= r)
+                return "R" + std::to_string(i);
+            if(i <= r + a)
+                return "A" + std::to_string(i - r);
+            if(i <= r + a + p)
+                return "P" + std::to_string(i - r - a);
+            return "J" + std::to_string(i - r - a - p);
+        }
+};
+
+class SliceGraph : public SliceNumbering{
+    public:
+        // Edges: tail[k] -> head[k] of type type[k]
+        std::vector<int> tail, head;
+        std::vector<uint8_t> type;
+        // Method to set the vertices (in any order; only the counts of every kind matter) and
+        // drop the edges
+        void set_nodes(const std::vector<std::string>& V){
+            n = int(V.size());
+            r = a = p = 0;
+            for(const std::string& v : V){
+                if(v[0] == 'R')
+                    r++;
+                else if(v[0] == 'A')
+                    a++;
+                else if(v[0] == 'P')
+                    p++;
+            }
+            tail.clear();
+            head.clear();
+            type.clear();
+        }
+        // Method to add the edge t -> h of the given type (node indices, type in 1..6)
+        void add_edge(int t, int h, int edge_type){
+            tail.push_back(t);
+            head.push_back(h);
+            type.push_back(uint8_t(edge_type));
+        }
+        // Method to read an ABDG from a stream (exits on malformed input, naming the source);
+        // the interactive slicers pass prompt to have each part of the input asked for
+        void read(std::istream& in, const std::string& source, std::ostream* prompt = nullptr){
+            int count;
+            if(prompt)
+                *prompt<<"Enter the number of vertices: ";
+            if(!(in>>count) || count < 1){
+                std::cerr<<"Error: Expected the number of vertices in "<<source<<std::endl;
+                exit(1);
+            }
+            if(prompt)
+                *prompt<<"Enter the "<<count<<" vertices: "<<std::endl;
+            std::vector<std::string> V(count);
+            for(std::string& v : V)
+                if(!(in>>v)){
+                    std::cerr<<"Error: Expected "<<count<<" vertices in "<<source<<std::endl;
+                    exit(1);
+                }
+            set_nodes(V);
+            int e;
+            if(prompt)
+                *prompt<<"Enter the number of edges: ";
+            if(!(in>>e) || e < 0){
+                std::cerr<<"Error: Expected the number of edges in "<<source<<std::endl;
+                exit(1);
+            }
+            if(prompt)
+                *prompt<<"Enter edges as tail <space> head <space> edge_type: "<<std::endl;
+            std::string t, h;
+            int edge_type;
+            for(int k = 0; k < e; k++){
+                if(!(in>>t>>h>>edge_type)){
+                    std::cerr<<"Error: Expected "<<e<<" edges in "<<source<<std::endl;
+                    exit(1);
+                }
+                if(index(t) < 0 || index(h) < 0){
+                    std::cerr<<"Error: Unknown node in edge "<<t<<" "<<h<<std::endl;
+                    exit(1);
+                }
+                if(edge_type < 1 || edge_type >= EDGE_TYPES){
+                    std::cerr<<"Error: Unknown edge type "<<edge_type<<std::endl;
+                    exit(1);
+                }
+                add_edge(index(t), index(h), edge_type);
+            }
+        }
+        // Method to read the ABDG of the given file
+        void load(const std::string& file){
+            std::ifstream fs(file);
+            if(!fs.is_open()){
+                std::cerr<<"Error: Could not open graph file "<<file<<std::endl;
+                exit(1);
+            }
+            read(fs, file);
+        }
+};
+
+// Per-query traversal buffers of the SliceCSR kernels. A SliceCSR is immutable once built, so
+// every thread querying it owns one of these and reuses it across its queries. Every array is
+// sized to the graph up front, so a query does no heap allocation, and marks are epoch stamps:
+// an entry belongs to the current query only if its stamp equals epoch, so starting a query is
+// one increment instead of a reset (the stamps are cleared only when the counter wraps around).
+struct SliceScratch{
+    uint32_t epoch = 0;
+
+    // DSABM_kernel(): stamps of the explored (node, phase) states and of the nodes in the slice,
+    // and one FIFO worklist per phase (a node enters each phase at most once per query)
+    std::vector<uint32_t> explored, sliced;
+    std::vector<int> worklist[DSABMScheme::PHASES];
+
+    // Best-first propagation state of the last criterion (at most DSABMScheme::PHASES phases):
+    // best relevance of every (node, phase) state and of every node, valid where their stamps
+    // are current, settled states, nodes reached, and a ring of relevance buckets (quantized
+    // -log2 of the relevance)
+    std::vector<double> state_relevance;
+    std::vector<uint32_t> state_epoch, settled;
+    std::vector<double> node_relevance;
+    std::vector<uint32_t> node_epoch;
+    std::vector<int> reached;
+    std::vector<std::vector<std::pair<double, int>>> buckets;
+
+    // Slice of the last query (nodes in discovery order) and relevance profile of the last
+    // criterion (see SliceCSR::more_relevant())
+    std::vector<int> slice;
+    std::vector<std::pair<double, int>> profile;
+
+    // chop_kernel(): (node, phase) states reached by the backward and by the forward search, in
+    // order; grown on the first chop query
+    std::vector<int> chop_queue[2];
+
+    SliceScratch(int n, size_t ring)
+        : explored(DSABMScheme::PHASES * n, 0), sliced(n, 0), state_relevance(DSABMScheme::PHASES * n, 0.0),
+          state_epoch(DSABMScheme::PHASES * n, 0), settled(DSABMScheme::PHASES * n, 0), node_relevance(n, 0.0),
+          node_epoch(n, 0), buckets(ring){
+        for(auto& w : worklist)
+            w.resize(n);
+        reached.reserve(n);
+        slice.reserve(n);
+        profile.reserve(n);
+    }
+
+    // Stamp of a new query
+    uint32_t next_epoch(){
+        if(++epoch == 0){
+            for(auto* stamps : {&explored, &sliced, &state_epoch, &settled, &node_epoch})
+                std::fill(stamps->begin(), stamps->end(), 0);
+            epoch = 1;
+        }
+        return epoch;
+    }
+};
+
+// Number of weight samples evaluated together by sensitivity(): every relevance is a block of
+// SENSITIVITY_LANES doubles, one per sample, so each relaxation is a fixed-width lane loop
+const int SENSITIVITY_LANES = 8;
+
+// Per-thread buffers of sensitivity(), laid out as one lane block per state and per node
+struct SensitivityScratch{
+    std::vector<double> state_relevance;
+    std::vector<double> node_relevance;
+    std::vector<char> queued, touched;
+    // Nodes touched by the current criterion and the queued states of the three phases, as
+    // max-heaps on the best lane of the state
+    std::vector<int> reached;
+    std::vector<std::pair<double, int>> queue[3];
+
+    explicit SensitivityScratch(int n = 0){
+        resize(n);
+    }
+    void resize(int n){
+        if(n <= int(touched.size()))
+            return;
+        state_relevance.assign(size_t(3) * n * SENSITIVITY_LANES, 0.0);
+        node_relevance.assign(size_t(n) * SENSITIVITY_LANES, 0.0);
+        queued.assign(3 * n, 0);
+        touched.assign(n, 0);
+    }
+};
+
+// Buffers of the multi-source DSABM (see SliceCSR::DSABM_multi()). Every node has WORDS 64-bit
+// words of lanes, one slice criterion per bit, so a traversal answers LANES criteria.
+template <int WORDS>
+struct LaneScratch{
+    static const int LANES = 64 * WORDS;
+    // Bit c of reach[ph][v * WORDS + c / 64] is set when criterion c explores v in phase ph + 1,
+    // delta holds the bits v has not propagated yet, and slice the criteria whose slice contains
+    // v. ring is the worklist of nodes, and nodes lists the nodes the traversal touched (marked
+    // in touched): all lanes are zero between traversals, and a traversal only clears those.
+    std::vector<uint64_t> reach[3], delta[3], slice;
+    std::vector<char> queued, touched;
+    std::vector<int> ring, nodes;
+    // mask[type][ph][q]: all ones if an edge of that type takes phase ph + 1 to phase q (q = 0:
+    // the tail only joins the slice)
+    uint64_t mask[EDGE_TYPES][3][4];
+    // Slices decoded from the lanes of the last traversal
+    std::vector<std::vector<int>> result;
+
+    LaneScratch() : result(LANES){
+        for(int type = 0; type < EDGE_TYPES; type++)
+            for(int ph = 0; ph < 3; ph++)
+                for(int q = 0; q < 4; q++)
+                    mask[type][ph][q] = DSABMScheme::next[ph][type] == q ? ~0ull : 0;
+    }
+    // Method to size the buffers to a graph of n nodes (once: they stay zero afterwards)
+    void resize(int n){
+        if(int(queued.size()) == n)
+            return;
+        for(int ph = 0; ph < 3; ph++){
+            reach[ph].assign(size_t(n) * WORDS, 0);
+            delta[ph].assign(size_t(n) * WORDS, 0);
+        }
+        slice.assign(size_t(n) * WORDS, 0);
+        queued.assign(n, 0);
+        touched.assign(n, 0);
+        ring.resize(n);
+        nodes.clear();
+    }
+};
+
+// Incident-Dependency List of an ABDG in CSR form, its transpose, and the slicing kernels on
+// them. Edges into node i are (IDL_tail[k], IDL_type[k]) for k in [IDL_off[i], IDL_off[i + 1]);
+// the arrays live in csr_* when built here, or wherever a loader points them (e.g. a mapped
+// binary file). The outgoing-dependency list, built by build_outgoing(), holds the edges out of
+// node i as (ODL_head[k], ODL_type[k]) for k in [ODL_off[i], ODL_off[i + 1]), ordered by head.
+// The kernels are const and keep their state in the scratch of the calling thread, so any
+// number of threads may query one SliceCSR; they take node ids and the phase scheme as a
+// template parameter.
+class SliceCSR : public SliceNumbering{
+    public:
+        // Number of edges
+        int e = 0;
+        const uint32_t* IDL_off = nullptr;
+        const uint32_t* IDL_tail = nullptr;
+        const uint8_t* IDL_type = nullptr;
+        std::vector<uint32_t> csr_off, csr_tail;
+        std::vector<uint8_t> csr_type;
+        std::vector<uint32_t> ODL_off, ODL_head;
+        std::vector<uint8_t> ODL_type;
+        // Load-time renumbering of a loader: position[c] is the id of the node whose name gives
+        // the canonical id c, canonical[v] the inverse; both are empty when the nodes keep the
+        // canonical order. The arrays above are indexed by the ids, names only by canonical ids.
+        std::vector<int> position, canonical;
+        int internal_id(int c) const{
+            return position.empty() ? c : position[c];
+        }
+        int canonical_id(int v) const{
+            return canonical.empty() ? v : canonical[v];
+        }
+
+        // Order of a relevance profile, (relevance, canonical id): decreasing relevance, ties by
+        // increasing canonical id so that they do not depend on the node order
+        static bool more_relevant(const std::pair<double, int>& x, const std::pair<double, int>& y){
+            return x.first != y.first ? x.first > y.first : x.second < y.second;
+        }
+        static bool less_relevant(const std::pair<double, int>& x, const std::pair<double, int>& y){
+            return more_relevant(y, x);
+        }
+
+        // Buckets per halving of the relevance in the best-first queue of propagate()
+        static const int BUCKETS_PER_OCTAVE = 8;
+        // Bucket of a relevance w in (0, 1]: floor(-log2(w) * BUCKETS_PER_OCTAVE)
+        static int bucket_of(double w){
+            return int(-std::log2(w) * BUCKETS_PER_OCTAVE);
+        }
+        // Number of buckets in the ring of propagate(): keys of queued states span at most one
+        // edge cost beyond the current bucket
+        static size_t ring_size(){
+            int span = 0;
+            for(int type = 1; type < EDGE_TYPES; type++)
+                span = std::max(span, bucket_of(DSABMScheme::weight[type]) + 2);
+            size_t ring = 1;
+            while(ring < size_t(span))
+                ring <<= 1;
+            return ring;
+        }
+        // Traversal buffers for one thread
+        SliceScratch make_scratch() const{
+            return SliceScratch(n, ring_size());
+        }
+
+        // Method to build the IDL of a SliceGraph, every node keeping its edges in input order
+        void build(const SliceGraph& G){
+            SliceNumbering::operator=(G);
+            e = int(G.tail.size());
+            csr_off.assign(n + 1, 0);
+            for(int h : G.head)
+                csr_off[h + 1]++;
+            for(int i = 0; i < n; i++)
+                csr_off[i + 1] += csr_off[i];
+            csr_tail.resize(e);
+            csr_type.resize(e);
+            std::vector<uint32_t> fill(csr_off.begin(), csr_off.end() - 1);
+            for(int k = 0; k < e; k++){
+                uint32_t slot = fill[G.head[k]]++;
+                csr_tail[slot] = G.tail[k];
+                csr_type[slot] = G.type[k];
+            }
+            IDL_off = csr_off.data();
+            IDL_tail = csr_tail.data();
+            IDL_type = csr_type.data();
+            position.clear();
+            canonical.clear();
+        }
+
+        // Method to build the outgoing list: transposes the IDL by a parallel counting sort on
+        // the tail ids, on a pool with size() workers and run(count, task(worker, i)). Every
+        // out-edge is scattered as (head << 32 | IDL position) and the segment of every tail is
+        // sorted afterwards, so the list is the same for any thread schedule.
+        template <class Pool>
+        void build_outgoing(Pool& pool){
+            std::unique_ptr<std::atomic<uint32_t>[]> cursor(new std::atomic<uint32_t>[n]);
+            for(int i = 0; i < n; i++)
+                cursor[i].store(0, std::memory_order_relaxed);
+            size_t parts = pool.size() * 8;
+            pool.run(parts, [&](int, size_t part){
+                for(size_t k = e * part / parts; k < e * (part + 1) / parts; k++)
+                    cursor[IDL_tail[k]].fetch_add(1, std::memory_order_relaxed);
+            });
+            ODL_off.assign(n + 1, 0);
+            for(int i = 0; i < n; i++){
+                ODL_off[i + 1] = ODL_off[i] + cursor[i].load(std::memory_order_relaxed);
+                cursor[i].store(ODL_off[i], std::memory_order_relaxed);
+            }
+
+            std::vector<uint64_t> order(e);
+            pool.run(parts, [&](int, size_t part){
+                for(size_t v = n * part / parts; v < n * (part + 1) / parts; v++)
+                    for(uint32_t k = IDL_off[v]; k < IDL_off[v + 1]; k++)
+                        order[cursor[IDL_tail[k]].fetch_add(1, std::memory_order_relaxed)] = uint64_t(v) << 32 | k;
+            });
+            ODL_head.resize(e);
+            ODL_type.resize(e);
+            pool.run(parts, [&](int, size_t part){
+                for(size_t u = n * part / parts; u < n * (part + 1) / parts; u++){
+                    std::sort(order.begin() + ODL_off[u], order.begin() + ODL_off[u + 1]);
+                    for(uint32_t k = ODL_off[u]; k < ODL_off[u + 1]; k++){
+                        ODL_head[k] = uint32_t(order[k] >> 32);
+                        ODL_type[k] = IDL_type[uint32_t(order[k])];
+                    }
+                }
+            });
+        }
+
+        // Method to compute Dynamic Slice (Implementation of DSABM) under a phase scheme (see
+        // dsabm_phases.h), nodes in discovery order. No transition of the scheme leads back to an
+        // earlier phase, so each phase is complete once its worklist is empty.
+        template <class Scheme>
+        const std::vector<int>& DSABM_kernel(int start_node, SliceScratch& ws) const{
+            static_assert(forward_only<Scheme>(), "DSABM drains the phases in order");
+            static_assert(Scheme::PHASES <= DSABMScheme::PHASES, "SliceScratch holds DSABMScheme::PHASES worklists");
+            const int P = Scheme::PHASES;
+            const uint32_t epoch = ws.next_epoch();
+            int head[P], tail[P];
+            for(int ph = 0; ph < P; ph++)
+                head[ph] = tail[ph] = 0;
+            ws.slice.clear();
+            ws.worklist[0][tail[0]++] = start_node;
+            ws.explored[P * start_node] = epoch;
+
+            for(int ph = 0; ph < P; ph++){
+                while(head[ph] < tail[ph]){
+                    int v = ws.worklist[ph][head[ph]++];
+                    for(uint32_t k = IDL_off[v]; k < IDL_off[v + 1]; k++){
+                        int u = IDL_tail[k];
+                        int next = Scheme::next[ph][IDL_type[k]];
+                        if(next < 0)
+                            continue;
+                        if(ws.sliced[u] != epoch && u != start_node){
+                            ws.sliced[u] = epoch;
+                            ws.slice.push_back(u);
+                        }
+                        if(next > 0 && ws.explored[P * u + next - 1] != epoch){
+                            ws.explored[P * u + next - 1] = epoch;
+                            ws.worklist[next - 1][tail[next - 1]++] = u;
+                        }
+                    }
+                }
+            }
+            return ws.slice;
+        }
+
+        // Best-first (max-product Dijkstra) propagation of relevance from start_node under the
+        // phase scheme. State PHASES * v + (phase - 1) is v explored in that phase; states are
+        // settled in decreasing relevance order, so each one is expanded at most once with its
+        // exact maximal relevance. Buckets order states by quantized -log2(relevance) and the
+        // current bucket is kept as a max-heap on the exact relevance. Arrivals below tau are
+        // pruned; node_relevance[v] is the best relevance with which v joins the slice, for the
+        // v in reached (the criterion first).
+        template <class Scheme>
+        void propagate(int start_node, double tau, SliceScratch& ws) const{
+            static_assert(Scheme::PHASES <= DSABMScheme::PHASES, "SliceScratch holds DSABMScheme::PHASES states per node");
+            const int P = Scheme::PHASES;
+            const uint32_t epoch = ws.next_epoch();
+            ws.reached.clear();
+
+            const size_t mask = ws.buckets.size() - 1;
+            size_t pending = 1;
+            int current = 0;
+            ws.state_relevance[P * start_node] = 1.0;
+            ws.state_epoch[P * start_node] = epoch;
+            ws.buckets[0].push_back({1.0, P * start_node});
+            ws.node_relevance[start_node] = 0.0;
+            ws.node_epoch[start_node] = epoch;
+            ws.reached.push_back(start_node);
+
+            for(; pending; current++){
+                std::vector<std::pair<double, int>>& bucket = ws.buckets[current & mask];
+                std::make_heap(bucket.begin(), bucket.end());
+
+                while(!bucket.empty()){
+                    std::pop_heap(bucket.begin(), bucket.end());
+                    std::pair<double, int> top = bucket.back();
+                    bucket.pop_back();
+                    pending--;
+
+                    int state = top.second;
+                    if(ws.settled[state] == epoch)
+                        continue;
+                    ws.settled[state] = epoch;
+                    int v = state / P, phase = state % P + 1;
+
+                    for(uint32_t k = IDL_off[v]; k < IDL_off[v + 1]; k++){
+                        int u = IDL_tail[k];
+                        int type = IDL_type[k];
+                        // Edges the phase does not follow have weight 0 and fall under the threshold test
+                        double new_w = top.first * follow_weight<Scheme>(phase, type);
+                        if(new_w < tau || new_w == 0.0)
+                            continue;
+                        if(ws.node_epoch[u] != epoch){
+                            ws.node_epoch[u] = epoch;
+                            ws.node_relevance[u] = new_w;
+                            ws.reached.push_back(u);
+                        }
+                        else if(new_w > ws.node_relevance[u])
+                            ws.node_relevance[u] = new_w;
+                        int next = Scheme::next[phase - 1][type];
+                        if(next == 0)
+                            continue;
+
+                        int next_state = P * u + next - 1;
+                        if(ws.settled[next_state] == epoch)
+                            continue;
+                        if(ws.state_epoch[next_state] == epoch && new_w <= ws.state_relevance[next_state])
+                            continue;
+                        ws.state_epoch[next_state] = epoch;
+                        ws.state_relevance[next_state] = new_w;
+
+                        int b = bucket_of(new_w);
+                        ws.buckets[b & mask].push_back({new_w, next_state});
+                        if(b == current)
+                            std::push_heap(bucket.begin(), bucket.end());
+                        pending++;
+                    }
+                }
+            }
+        }
+
+        // Relevance profile of start_node: the maximal relevance of every node of its slice, from
+        // one propagate() without threshold, as (relevance, canonical id) in more_relevant() order.
+        // The slice for any tau is then the prefix of the profile with relevance >= tau.
+        template <class Scheme>
+        const std::vector<std::pair<double, int>>& profile_kernel(int start_node, SliceScratch& ws) const{
+            propagate<Scheme>(start_node, 0.0, ws);
+            ws.profile.clear();
+            for(size_t i = 1; i < ws.reached.size(); i++)
+                ws.profile.push_back({ws.node_relevance[ws.reached[i]], canonical_id(ws.reached[i])});
+            std::sort(ws.profile.begin(), ws.profile.end(), more_relevant);
+            return ws.profile;
+        }
+
+        // The k nodes of the slice of start_node with the highest relevance, in the order of
+        // profile_kernel(), computed by propagate() stopped early. A node's relevance is final
+        // once no queued state is more relevant (edge weights are at most 1), so the candidates
+        // are kept in a heap ordered by more_relevant() (profile) and handed out while the best
+        // of them is more relevant than the best queued state (a tie waits until the queue moves
+        // on, as a weight-1 edge may still bring in a node of the same relevance); the search
+        // stops at the k-th. Its cost follows the states more relevant than the k-th node, not
+        // the whole slice.
+        template <class Scheme>
+        const std::vector<int>& top_k(int start_node, size_t k, SliceScratch& ws) const{
+            static_assert(Scheme::PHASES <= DSABMScheme::PHASES, "SliceScratch holds DSABMScheme::PHASES states per node");
+            const int P = Scheme::PHASES;
+            const uint32_t epoch = ws.next_epoch();
+            ws.slice.clear();
+            ws.profile.clear();
+            if(k == 0)
+                return ws.slice;
+
+            const size_t mask = ws.buckets.size() - 1;
+            size_t pending = 1;
+            int current = 0;
+            ws.state_relevance[P * start_node] = 1.0;
+            ws.state_epoch[P * start_node] = epoch;
+            ws.buckets[0].push_back({1.0, P * start_node});
+            // sliced marks the nodes handed out
+            ws.node_epoch[start_node] = epoch;
+            ws.sliced[start_node] = epoch;
+
+            // Hands out the candidates more relevant than bound; false once there are k
+            auto hand_out = [&](double bound){
+                while(!ws.profile.empty() && ws.profile.front().first > bound){
+                    std::pop_heap(ws.profile.begin(), ws.profile.end(), less_relevant);
+                    int u = internal_id(ws.profile.back().second);
+                    bool stale = ws.profile.back().first != ws.node_relevance[u] || ws.sliced[u] == epoch;
+                    ws.profile.pop_back();
+                    if(stale)
+                        continue;
+                    ws.sliced[u] = epoch;
+                    ws.slice.push_back(u);
+                    if(ws.slice.size() == k)
+                        return false;
+                }
+                return true;
+            };
+
+            bool open = true;
+            for(; pending; current++){
+                std::vector<std::pair<double, int>>& bucket = ws.buckets[current & mask];
+                std::make_heap(bucket.begin(), bucket.end());
+
+                while(!bucket.empty() && (open = hand_out(bucket.front().first))){
+                    std::pop_heap(bucket.begin(), bucket.end());
+                    std::pair<double, int> top = bucket.back();
+                    bucket.pop_back();
+                    pending--;
+
+                    int state = top.second;
+                    if(ws.settled[state] == epoch)
+                        continue;
+                    ws.settled[state] = epoch;
+                    int v = state / P, phase = state % P + 1;
+
+                    for(uint32_t i = IDL_off[v]; i < IDL_off[v + 1]; i++){
+                        int u = IDL_tail[i];
+                        int type = IDL_type[i];
+                        double new_w = top.first * follow_weight<Scheme>(phase, type);
+                        if(new_w == 0.0)
+                            continue;
+                        if(u != start_node && (ws.node_epoch[u] != epoch || new_w > ws.node_relevance[u])){
+                            ws.node_epoch[u] = epoch;
+                            ws.node_relevance[u] = new_w;
+                            ws.profile.push_back({new_w, canonical_id(u)});
+                            std::push_heap(ws.profile.begin(), ws.profile.end(), less_relevant);
+                        }
+                        int next = Scheme::next[phase - 1][type];
+                        if(next == 0)
+                            continue;
+
+                        int next_state = P * u + next - 1;
+                        if(ws.settled[next_state] == epoch)
+                            continue;
+                        if(ws.state_epoch[next_state] == epoch && new_w <= ws.state_relevance[next_state])
+                            continue;
+                        ws.state_epoch[next_state] = epoch;
+                        ws.state_relevance[next_state] = new_w;
+
+                        int b = bucket_of(new_w);
+                        ws.buckets[b & mask].push_back({new_w, next_state});
+                        if(b == current)
+                            std::push_heap(bucket.begin(), bucket.end());
+                        pending++;
+                    }
+                }
+                if(!open)
+                    break;
+            }
+            if(open)
+                hand_out(0.0);
+            // Stopped early: the ring must be empty for the next query
+            for(; pending; current++){
+                pending -= ws.buckets[current & mask].size();
+                ws.buckets[current & mask].clear();
+            }
+            return ws.slice;
+        }
+
+        // Forward DSABM: the backward automaton run in reverse over the outgoing-dependency list
+        // (see ForwardScheme), so that the result is every node whose slice contains start_node.
+        // Backward transitions never lead to an earlier phase, so the reversed ones never lead
+        // to a later one: the phases are drained from the last to the first, each (node, phase)
+        // state being explored at most once.
+        template <class Scheme>
+        const std::vector<int>& forward_kernel(int start_node, SliceScratch& ws) const{
+            static_assert(forward_only<Scheme>(), "the forward traversal drains the phases in reverse order");
+            static_assert(Scheme::PHASES <= DSABMScheme::PHASES, "SliceScratch holds DSABMScheme::PHASES worklists");
+            static const ForwardScheme<Scheme> fwd;
+            const int P = Scheme::PHASES;
+            const uint32_t epoch = ws.next_epoch();
+            int head[P], tail[P];
+            for(int ph = 0; ph < P; ph++)
+                head[ph] = tail[ph] = 0;
+            ws.slice.clear();
+
+            // Explores w in the phases of the mask; w joins the forward slice in phase 1
+            auto reach = [&](int w, int phases){
+                for(int ph = 0; ph < P; ph++){
+                    if(!(phases >> ph & 1) || ws.explored[P * w + ph] == epoch)
+                        continue;
+                    ws.explored[P * w + ph] = epoch;
+                    ws.worklist[ph][tail[ph]++] = w;
+                    if(ph == 0 && w != start_node)
+                        ws.slice.push_back(w);
+                }
+            };
+            for(uint32_t k = ODL_off[start_node]; k < ODL_off[start_node + 1]; k++)
+                reach(ODL_head[k], fwd.start[ODL_type[k]]);
+            for(int ph = P - 1; ph >= 0; ph--){
+                while(head[ph] < tail[ph]){
+                    int v = ws.worklist[ph][head[ph]++];
+                    for(uint32_t k = ODL_off[v]; k < ODL_off[v + 1]; k++)
+                        reach(ODL_head[k], fwd.from[ph][ODL_type[k]]);
+                }
+            }
+            return ws.slice;
+        }
+
+        // Best-first propagation of forward_kernel(): the relevance of a forward state is the
+        // best product of edge weights between it and start_node, i.e. the relevance start_node
+        // would have in the slice of a criterion explored in that state. The states are settled
+        // in decreasing relevance order with the bucket ring of propagate(); a node joins when
+        // its phase-1 state settles, with the relevance start_node has in its slice (>= tau).
+        // Nodes are in reached, the criterion first, with their relevance in node_relevance.
+        template <class Scheme>
+        void propagate_forward(int start_node, double tau, SliceScratch& ws) const{
+            static_assert(Scheme::PHASES <= DSABMScheme::PHASES, "SliceScratch holds DSABMScheme::PHASES states per node");
+            static const ForwardScheme<Scheme> fwd;
+            const int P = Scheme::PHASES;
+            const uint32_t epoch = ws.next_epoch();
+            ws.reached.clear();
+            ws.node_relevance[start_node] = 0.0;
+            ws.node_epoch[start_node] = epoch;
+            ws.reached.push_back(start_node);
+
+            const size_t mask = ws.buckets.size() - 1;
+            size_t pending = 0;
+            int current = 0;
+            bool draining = false;
+            // Queues the states of w in the phases of the mask with relevance new_w
+            auto relax = [&](int w, int phases, double new_w){
+                if(new_w < tau || new_w == 0.0)
+                    return;
+                for(int ph = 0; ph < P; ph++){
+                    int state = P * w + ph;
+                    if(!(phases >> ph & 1) || ws.settled[state] == epoch)
+                        continue;
+                    if(ws.state_epoch[state] == epoch && new_w <= ws.state_relevance[state])
+                        continue;
+                    ws.state_epoch[state] = epoch;
+                    ws.state_relevance[state] = new_w;
+                    int b = bucket_of(new_w);
+                    std::vector<std::pair<double, int>>& bucket = ws.buckets[b & mask];
+                    bucket.push_back({new_w, state});
+                    if(draining && b == current)
+                        std::push_heap(bucket.begin(), bucket.end());
+                    pending++;
+                }
+            };
+            for(uint32_t k = ODL_off[start_node]; k < ODL_off[start_node + 1]; k++){
+                int type = ODL_type[k];
+                relax(ODL_head[k], fwd.start[type], Scheme::weight[type]);
+            }
+
+            for(draining = true; pending; current++){
+                std::vector<std::pair<double, int>>& bucket = ws.buckets[current & mask];
+                std::make_heap(bucket.begin(), bucket.end());
+
+                while(!bucket.empty()){
+                    std::pop_heap(bucket.begin(), bucket.end());
+                    std::pair<double, int> top = bucket.back();
+                    bucket.pop_back();
+                    pending--;
+
+                    int state = top.second;
+                    if(ws.settled[state] == epoch)
+                        continue;
+                    ws.settled[state] = epoch;
+                    int v = state / P, ph = state % P;
+                    if(ph == 0 && v != start_node && ws.node_epoch[v] != epoch){
+                        ws.node_epoch[v] = epoch;
+                        ws.node_relevance[v] = top.first;
+                        ws.reached.push_back(v);
+                    }
+                    for(uint32_t k = ODL_off[v]; k < ODL_off[v + 1]; k++){
+                        int type = ODL_type[k];
+                        relax(ODL_head[k], fwd.from[ph][type], top.first * Scheme::weight[type]);
+                    }
+                }
+            }
+        }
+
+        // Chop of source and target: the nodes on the dependency paths the DSABM of target
+        // follows down to source, source and target included (empty when source is not in the
+        // slice of target). A (node, phase) state is on such a path exactly when the backward
+        // search from (target, 1) reaches it and the forward search from source (see
+        // forward_kernel()) does too. Both searches run at once, the one with the smaller
+        // frontier moving first. Once one of them is complete, the other only explores the
+        // states the complete one reached: every state on a path from target to source is in
+        // both sets, so the other one visits the chop and little else; if the complete search
+        // never met the other endpoint, the chop is empty and nothing more is done.
+        template <class Scheme>
+        const std::vector<int>& chop_kernel(int source, int target, SliceScratch& ws) const{
+            static_assert(Scheme::PHASES <= DSABMScheme::PHASES, "SliceScratch holds DSABMScheme::PHASES states per node");
+            static const ForwardScheme<Scheme> fwd;
+            const int P = Scheme::PHASES;
+            const uint32_t epoch = ws.next_epoch();
+            ws.slice.clear();
+            // Side 0 is the backward search, side 1 the forward one; done is the complete side,
+            // -1 before
+            uint32_t* seen[2] = {ws.explored.data(), ws.state_epoch.data()};
+            std::vector<int>* queue = ws.chop_queue;
+            size_t head[2] = {0, 0};
+            int done = -1;
+            bool met_source = false;
+            queue[0].clear();
+            queue[1].clear();
+
+            auto visit = [&](int side, int state){
+                if(seen[side][state] == epoch || (done >= 0 && seen[done][state] != epoch))
+                    return;
+                seen[side][state] = epoch;
+                queue[side].push_back(state);
+            };
+            visit(0, P * target);
+            for(uint32_t k = ODL_off[source]; k < ODL_off[source + 1]; k++)
+                for(int ph = 0; ph < P; ph++)
+                    if(fwd.start[ODL_type[k]] >> ph & 1)
+                        visit(1, P * ODL_head[k] + ph);
+
+            while(true){
+                int side = 1 - done;
+                if(done < 0){
+                    size_t frontier[2] = {queue[0].size() - head[0], queue[1].size() - head[1]};
+                    if(!frontier[0] || !frontier[1]){
+                        done = frontier[0] ? 1 : 0;
+                        if(done == 0 ? !met_source : seen[1][P * target] != epoch)
+                            return ws.slice;
+                        continue;
+                    }
+                    side = frontier[0] <= frontier[1] ? 0 : 1;
+                }
+                if(head[side] == queue[side].size())
+                    break;
+                int state = queue[side][head[side]++];
+                // Queued before the other search was complete, and not on a path
+                if(done >= 0 && seen[done][state] != epoch)
+                    continue;
+                int v = state / P, ph = state % P;
+                if(side == 0){
+                    for(uint32_t k = IDL_off[v]; k < IDL_off[v + 1]; k++){
+                        int next = Scheme::next[ph][IDL_type[k]];
+                        if(next < 0)
+                            continue;
+                        if(int(IDL_tail[k]) == source)
+                            met_source = true;
+                        if(next > 0)
+                            visit(0, P * IDL_tail[k] + next - 1);
+                    }
+                }
+                else{
+                    for(uint32_t k = ODL_off[v]; k < ODL_off[v + 1]; k++)
+                        for(int q = 0; q < P; q++)
+                            if(fwd.from[ph][ODL_type[k]] >> q & 1)
+                                visit(1, P * ODL_head[k] + q);
+                }
+            }
+
+            // The chop states are those of the incomplete search that the complete one reached too
+            auto add = [&](int v){
+                if(ws.sliced[v] == epoch)
+                    return;
+                ws.sliced[v] = epoch;
+                ws.slice.push_back(v);
+            };
+            for(int state : queue[1 - done])
+                if(seen[done][state] == epoch)
+                    add(state / P);
+            add(source);
+            return ws.slice;
+        }
+
+        // Pruned slice sizes of start_node under SENSITIVITY_LANES weight samples in one
+        // traversal: weights[type * SENSITIVITY_LANES + l] is the weight of the edge type in
+        // sample l, and sizes[l] receives the size of the slice of sample l. The samples rank the
+        // states differently, so no single order settles every lane at once as in propagate():
+        // the states are relaxed to a fixpoint instead (label-correcting), a state being queued
+        // again whenever any of its lanes improves. Expanding the state with the best lane first
+        // keeps the re-expansions rare, the samples being close to each other. Phases only ever
+        // move forward, so phase 1 is drained before phase 2, and phase 2 before 3. Every lane
+        // ends with the relevance propagate() computes under the weights of its sample.
+        void sensitivity(int start_node, double tau, const double* weights, SensitivityScratch& ws, int* sizes) const{
+            const int L = SENSITIVITY_LANES;
+            ws.reached.push_back(start_node);
+            ws.touched[start_node] = 1;
+            for(int l = 0; l < L; l++)
+                ws.state_relevance[size_t(3) * start_node * L + l] = 1.0;
+            ws.queue[0].push_back({1.0, 3 * start_node});
+            ws.queued[3 * start_node] = 1;
+
+            double current[SENSITIVITY_LANES], new_w[SENSITIVITY_LANES];
+            for(int ph = 0; ph < 3; ph++){
+                std::vector<std::pair<double, int>>& queue = ws.queue[ph];
+                while(!queue.empty()){
+                    std::pop_heap(queue.begin(), queue.end());
+                    int state = queue.back().second;
+                    queue.pop_back();
+                    // Entries left behind by an improvement of a queued state are stale
+                    if(!ws.queued[state])
+                        continue;
+                    ws.queued[state] = 0;
+                    std::memcpy(current, &ws.state_relevance[size_t(state) * L], sizeof(current));
+                    int v = state / 3;
+
+                    for(uint32_t k = IDL_off[v]; k < IDL_off[v + 1]; k++){
+                        int u = IDL_tail[k];
+                        int type = IDL_type[k];
+                        int next = DSABMScheme::next[ph][type];
+                        if(next < 0)
+                            continue;
+
+                        const double* w = weights + type * L;
+                        double* node = &ws.node_relevance[size_t(u) * L];
+                        int alive = 0;
+                        for(int l = 0; l < L; l++){
+                            new_w[l] = current[l] * w[l];
+                            new_w[l] = new_w[l] >= tau ? new_w[l] : 0.0;
+                            node[l] = std::max(node[l], new_w[l]);
+                            alive += new_w[l] > 0.0;
+                        }
+                        if(!alive)
+                            continue;
+                        if(!ws.touched[u]){
+                            ws.touched[u] = 1;
+                            ws.reached.push_back(u);
+                        }
+                        if(next == 0)
+                            continue;
+
+                        int next_state = 3 * u + next - 1;
+                        double* target = &ws.state_relevance[size_t(next_state) * L];
+                        int improved = 0;
+                        double best = 0.0;
+                        for(int l = 0; l < L; l++){
+                            improved += new_w[l] > target[l];
+                            target[l] = std::max(target[l], new_w[l]);
+                            best = std::max(best, target[l]);
+                        }
+                        if(improved){
+                            ws.queued[next_state] = 1;
+                            ws.queue[next - 1].push_back({best, next_state});
+                            std::push_heap(ws.queue[next - 1].begin(), ws.queue[next - 1].end());
+                        }
+                    }
+                }
+            }
+
+            // Count the slice of every lane and reset the touched nodes for the next call
+            for(int l = 0; l < L; l++)
+                sizes[l] = 0;
+            for(int u : ws.reached){
+                double* node = &ws.node_relevance[size_t(u) * L];
+                if(u != start_node)
+                    for(int l = 0; l < L; l++)
+                        sizes[l] += node[l] > 0.0;
+                std::memset(node, 0, L * sizeof(double));
+                std::memset(&ws.state_relevance[size_t(3) * u * L], 0, 3 * L * sizeof(double));
+                ws.touched[u] = 0;
+            }
+            ws.reached.clear();
+        }
+
+        // Bit-parallel DSABM of up to LANES criteria in one traversal, the slice of sources[c] in
+        // ls.result[c] (nodes in index order): the phase rules become lane masks, so every
+        // incoming edge moves the pending bits of all criteria and phases at once. A node is
+        // re-queued only when it gains new bits, hence each (criterion, phase, node) is
+        // propagated at most once. Only the touched nodes are decoded and cleared, so a
+        // traversal costs what it visits, not the size of the graph.
+        template <int WORDS>
+        void DSABM_multi(const std::vector<int>& sources, LaneScratch<WORDS>& ls) const{
+            ls.resize(n);
+            int head = 0, count = 0;
+            auto touch = [&ls](int v){
+                if(!ls.touched[v]){
+                    ls.touched[v] = 1;
+                    ls.nodes.push_back(v);
+                }
+            };
+            for(size_t c = 0; c < sources.size(); c++){
+                int v = sources[c];
+                ls.reach[0][size_t(v) * WORDS + c / 64] |= 1ull << (c % 64);
+                ls.delta[0][size_t(v) * WORDS + c / 64] |= 1ull << (c % 64);
+                touch(v);
+                if(!ls.queued[v]){
+                    ls.queued[v] = 1;
+                    ls.ring[(head + count++) % n] = v;
+                }
+            }
+            uint64_t d[3][WORDS];
+            while(count){
+                int v = ls.ring[head];
+                head = (head + 1) % n;
+                count--;
+                ls.queued[v] = 0;
+                for(int ph = 0; ph < 3; ph++)
+                    for(int w = 0; w < WORDS; w++){
+                        d[ph][w] = ls.delta[ph][size_t(v) * WORDS + w];
+                        ls.delta[ph][size_t(v) * WORDS + w] = 0;
+                    }
+                for(uint32_t k = IDL_off[v]; k < IDL_off[v + 1]; k++){
+                    int u = IDL_tail[k];
+                    const uint64_t (*mask)[4] = ls.mask[IDL_type[k]];
+                    bool grown = false, joined_any = false;
+                    for(int w = 0; w < WORDS; w++){
+                        size_t at = size_t(u) * WORDS + w;
+                        uint64_t joined = 0;
+                        for(int q = 0; q < 4; q++){
+                            uint64_t arrived = (d[0][w] & mask[0][q]) | (d[1][w] & mask[1][q]) | (d[2][w] & mask[2][q]);
+                            joined |= arrived;
+                            if(q == 0)
+                                continue;
+                            uint64_t fresh = arrived & ~ls.reach[q - 1][at];
+                            ls.reach[q - 1][at] |= fresh;
+                            ls.delta[q - 1][at] |= fresh;
+                            grown |= fresh != 0;
+                        }
+                        ls.slice[at] |= joined;
+                        joined_any |= joined != 0;
+                    }
+                    if(joined_any)
+                        touch(u);
+                    if(grown && !ls.queued[u]){
+                        ls.queued[u] = 1;
+                        ls.ring[(head + count++) % n] = u;
+                    }
+                }
+            }
+            // Decode the slices, skipping each criterion itself, and clear the touched lanes (the
+            // deltas are already drained). The touched nodes are taken in index order: sorted
+            // when they are few, by a scan of the marks when they are most of the graph.
+            for(size_t c = 0; c < sources.size(); c++)
+                ls.result[c].clear();
+            auto decode = [&](int u){
+                for(int w = 0; w < WORDS; w++){
+                    size_t at = size_t(u) * WORDS + w;
+                    for(uint64_t bits = ls.slice[at]; bits; bits &= bits - 1){
+                        size_t c = w * 64 + __builtin_ctzll(bits);
+                        if(c < sources.size() && sources[c] != u)
+                            ls.result[c].push_back(u);
+                    }
+                    ls.slice[at] = 0;
+                    for(int ph = 0; ph < 3; ph++)
+                        ls.reach[ph][at] = 0;
+                }
+                ls.touched[u] = 0;
+            };
+            if(ls.nodes.size() * 16 < size_t(n)){
+                std::sort(ls.nodes.begin(), ls.nodes.end());
+                for(int u : ls.nodes)
+                    decode(u);
+            }
+            else
+                for(int u = 0; u < n; u++)
+                    if(ls.touched[u])
+                        decode(u);
+            ls.nodes.clear();
+        }
+};
+
+// The DSABM of every backend drains the phases in order, each complete once its worklist is empty
+static_assert(forward_only<DSABMScheme>(), "DSABM drains the phases in order");
+
+class Slicer{
+    public:
+        virtual ~Slicer(){}
+        // Name of the backend
+        virtual const char* name() const = 0;
+        // Method to build the graph representation of the backend
+        virtual void build(const SliceGraph& G) = 0;
+        // True if the backend answers relevance-pruned queries
+        virtual bool weighted() const{
+            return false;
+        }
+        // Method to compute Dynamic Slice (Implementation of DSABM); the criterion is not part of it
+        virtual const std::vector<int>& DSABM(int s) = 0;
+        // Method to compute the slice of the nodes with relevance >= tau (weighted backends only)
+        virtual const std::vector<int>& DSABM_Integrated(int s, double tau){
+            (void)tau;
+            return DSABM(s);
+        }
+};
+
+// 256 cells of a bit plane, a GCC vector: the scans below are written on whole blocks and compile
+// to AVX2 instructions with -mavx2 (-march=native), to pairs of SSE2 instructions otherwise.
+// The planes are stored as 64-bit words and viewed as blocks, so a block only needs the alignment
+// of a word (std::allocator does not honour wider ones before C++17).
+typedef uint64_t SliceBlock __attribute__((vector_size(32), aligned(8), may_alias));
+const int SLICE_BLOCK_WORDS = 4;
+
+// Blocks view of a bit vector
+inline SliceBlock* as_blocks(std::vector<uint64_t>& words){
+    return reinterpret_cast<SliceBlock*>(words.data());
+}
+
+// Dependency matrix backend, stored column-major and bit-packed: one bit plane per edge type in
+// every column, so a cell keeps all the edges between its two nodes in 6 bits instead of an int,
+// and a summary bitmap of the non-empty 256-cell blocks of every column lets a scan skip empty ones
+class MatrixSlicer : public Slicer{
+    public:
+        // Cells per block
+        static const int BLOCK_BITS = 256;
+    private:
+        // Bit planes per column, one per edge type 1-6
+        static const int PLANES = EDGE_TYPES - 1;
+        int n = 0, nblocks = 0, summary_words = 0;
+        // Plane k of column v (the tails of the edges with head v) is the run of blocks
+        // [(v * PLANES + k) * nblocks, ...); bit t of plane k is set if there is an edge t -> v
+        // of type k + 1
+        std::vector<uint64_t> D;
+        // Bit k % 64 of word summary[v * summary_words + k / 64] is set if block k of column v
+        // holds an edge
+        std::vector<uint64_t> summary;
+        // Traversal buffers: explored nodes of every phase and nodes of the slice, one bit each,
+        // and one FIFO worklist per phase
+        std::vector<uint64_t> explored[DSABMScheme::PHASES], sliced;
+        std::vector<int> worklist[DSABMScheme::PHASES];
+        std::vector<int> result;
+        // Method to view column v as blocks
+        const SliceBlock* column(int v) const{
+            return reinterpret_cast<const SliceBlock*>(D.data()) + size_t(v) * PLANES * nblocks;
+        }
+    public:
+        const char* name() const{
+            return "matrix";
+        }
+        // Blocks per column
+        int blocks() const{
+            return nblocks;
+        }
+        // Method to unpack block b of column v into the edge types of its 256 cells (0: no edge);
+        // a cell holding parallel edges of different types shows the highest of them
+        void decode(int v, int b, uint8_t* types) const{
+            const SliceBlock* col = column(v);
+            for(int i = 0; i < BLOCK_BITS; i++){
+                types[i] = 0;
+                for(int k = 0; k < PLANES; k++)
+                    if(col[k * nblocks + b][i / 64] >> (i % 64) & 1)
+                        types[i] = uint8_t(k + 1);
+            }
+        }
+        // Edge type of the cell of the edge t -> h, 0 if there is none (the highest type of
+        // parallel edges, as decode())
+        int cell(int t, int h) const{
+            int type = 0;
+            for(int k = 0; k < PLANES; k++)
+                if(D[(size_t(h) * PLANES + k) * nblocks * SLICE_BLOCK_WORDS + t / 64] >> (t % 64) & 1)
+                    type = k + 1;
+            return type;
+        }
+        void build(const SliceGraph& G){
+            n = G.n;
+            nblocks = (n + BLOCK_BITS - 1) / BLOCK_BITS;
+            summary_words = (nblocks + 63) / 64;
+            D.assign(size_t(n) * PLANES * nblocks * SLICE_BLOCK_WORDS, 0);
+            summary.assign(size_t(n) * summary_words, 0);
+            for(size_t e = 0; e < G.tail.size(); e++){
+                int u = G.tail[e], v = G.head[e], b = u / BLOCK_BITS;
+                D[(size_t(v) * PLANES + G.type[e] - 1) * nblocks * SLICE_BLOCK_WORDS + u / 64] |= 1ull << (u % 64);
+                summary[size_t(v) * summary_words + b / 64] |= 1ull << (b % 64);
+            }
+            for(int ph = 0; ph < DSABMScheme::PHASES; ph++){
+                explored[ph].assign(size_t(nblocks) * SLICE_BLOCK_WORDS, 0);
+                worklist[ph].resize(n);
+            }
+            sliced.assign(size_t(nblocks) * SLICE_BLOCK_WORDS, 0);
+            result.reserve(n);
+        }
+        const std::vector<int>& DSABM(int s){
+            const int P = DSABMScheme::PHASES;
+            int head[P], tail[P];
+            SliceBlock* ex[P];
+            for(int ph = 0; ph < P; ph++){
+                head[ph] = tail[ph] = 0;
+                std::fill(explored[ph].begin(), explored[ph].end(), 0);
+                ex[ph] = as_blocks(explored[ph]);
+            }
+            std::fill(sliced.begin(), sliced.end(), 0);
+            SliceBlock* sl = as_blocks(sliced);
+            worklist[0][tail[0]++] = s;
+            explored[0][s / 64] |= 1ull << (s % 64);
+            // Phases in order: every edge decision is a lookup of the phase table, and a zero
+            // cell of the matrix is a rejected edge
+            for(int ph = 0; ph < P; ph++){
+                while(head[ph] < tail[ph]){
+                    int v = worklist[ph][head[ph]++];
+                    const SliceBlock* col = column(v);
+                    const uint64_t* sum = &summary[size_t(v) * summary_words];
+                    for(int k = 0; k < summary_words; k++)
+                        for(uint64_t nonzero = sum[k]; nonzero; nonzero &= nonzero - 1){
+                            int b = k * 64 + __builtin_ctzll(nonzero);
+                            // Classify the 256 cells at once: to[q] holds the tails with an edge that
+                            // takes phase ph + 1 to phase q (q = 0: the tail only joins the slice)
+                            SliceBlock to[P + 1] = {};
+                            for(int type = 1; type < EDGE_TYPES; type++){
+                                int q = DSABMScheme::next[ph][type];
+                                if(q >= 0)
+                                    to[q] |= col[(type - 1) * nblocks + b];
+                            }
+                            SliceBlock any = to[0];
+                            for(int q = 1; q <= P; q++){
+                                any |= to[q];
+                                SliceBlock fresh = to[q] & ~ex[q - 1][b];
+                                ex[q - 1][b] |= fresh;
+                                for(int w = 0; w < SLICE_BLOCK_WORDS; w++)
+                                    for(uint64_t bits = fresh[w]; bits; bits &= bits - 1)
+                                        worklist[q - 1][tail[q - 1]++] = b * BLOCK_BITS + w * 64 + __builtin_ctzll(bits);
+                            }
+                            sl[b] |= any;
+                        }
+                }
+            }
+            result.clear();
+            for(size_t w = 0; w < sliced.size(); w++)
+                for(uint64_t bits = sliced[w]; bits; bits &= bits - 1){
+                    int u = int(w * 64 + __builtin_ctzll(bits));
+                    if(u != s)
+                        result.push_back(u);
+                }
+            return result;
+        }
+};
+
+// Incident-Dependency List backend: the (tail, edge_type) pairs of the edges incident on every
+// node in a vector of their own
+class ListSlicer : public Slicer{
+        std::vector<std::vector<std::pair<int, int>>> IDL;
+        // Traversal buffers: epoch stamps of the explored (node, phase) states and of the nodes
+        // in the slice, and one FIFO worklist per phase
+        uint32_t epoch = 0;
+        std::vector<uint32_t> explored, sliced;
+        std::vector<int> worklist[DSABMScheme::PHASES];
+        std::vector<int> result;
+    public:
+        const char* name() const{
+            return "list";
+        }
+        // Incident edges of node v as (tail, edge_type) pairs, in input order
+        const std::vector<std::pair<int, int>>& incident(int v) const{
+            return IDL[v];
+        }
+        void build(const SliceGraph& G){
+            IDL.assign(G.n, std::vector<std::pair<int, int>>());
+            for(size_t k = 0; k < G.tail.size(); k++)
+                IDL[G.head[k]].push_back({G.tail[k], G.type[k]});
+            explored.assign(size_t(DSABMScheme::PHASES) * G.n, 0);
+            sliced.assign(G.n, 0);
+            for(auto& w : worklist)
+                w.resize(G.n);
+            result.reserve(G.n);
+        }
+        const std::vector<int>& DSABM(int s){
+            const int P = DSABMScheme::PHASES;
+            if(++epoch == 0){
+                std::fill(explored.begin(), explored.end(), 0);
+                std::fill(sliced.begin(), sliced.end(), 0);
+                epoch = 1;
+            }
+            int head[P], tail[P];
+            for(int ph = 0; ph < P; ph++)
+                head[ph] = tail[ph] = 0;
+            result.clear();
+            worklist[0][tail[0]++] = s;
+            explored[P * s] = epoch;
+            for(int ph = 0; ph < P; ph++){
+                while(head[ph] < tail[ph]){
+                    int v = worklist[ph][head[ph]++];
+                    for(const std::pair<int, int>& edge : IDL[v]){
+                        int u = edge.first, q = DSABMScheme::next[ph][edge.second];
+                        if(q < 0)
+                            continue;
+                        if(sliced[u] != epoch && u != s){
+                            sliced[u] = epoch;
+                            result.push_back(u);
+                        }
+                        if(q > 0 && explored[P * u + q - 1] != epoch){
+                            explored[P * u + q - 1] = epoch;
+                            worklist[q - 1][tail[q - 1]++] = u;
+                        }
+                    }
+                }
+            }
+            return result;
+        }
+};
+
+// Weighted backend: a SliceCSR and the scratch of its kernels, the engine of dsabm_integrated. The
+// DSABM is DSABM_kernel(), and a pruned slice the nodes reached by propagate() (best-first,
+// max-product relevance over the (node, phase) states) with a relevance >= tau.
+class WeightedSlicer : public Slicer{
+        SliceCSR G;
+        SliceScratch ws{0, 1};
+    public:
+        const char* name() const{
+            return "weighted";
+        }
+        bool weighted() const{
+            return true;
+        }
+        void build(const SliceGraph& graph){
+            G.build(graph);
+            ws = G.make_scratch();
+        }
+        const std::vector<int>& DSABM(int s){
+            return G.DSABM_kernel<DSABMScheme>(s, ws);
+        }
+        const std::vector<int>& DSABM_Integrated(int s, double tau){
+            G.propagate<DSABMScheme>(s, tau, ws);
+            // reached[0] is the criterion itself
+            ws.slice.assign(ws.reached.begin() + 1, ws.reached.end());
+            return ws.slice;
+        }
+};
+
+// Backend of the given name (see SLICER_NAMES), nullptr if there is none
+inline std::unique_ptr<Slicer> make_slicer(const std::string& name){
+    if(name == "matrix")
+        return std::unique_ptr<Slicer>(new MatrixSlicer());
+    if(name == "list")
+        return std::unique_ptr<Slicer>(new ListSlicer());
+    if(name == "weighted")
+        return std::unique_ptr<Slicer>(new WeightedSlicer());
+    return nullptr;
+}
+
+#endif
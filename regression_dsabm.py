@@ -0,0 +1,167 @@
+import argparse
+import difflib
+import glob
+import os
+import subprocess
+import sys
+import tempfile
+
+# Regression check of the batch front ends: every backend answers every query mode it supports
+# for every node of input_file.txt and of the case studies, and its output is compared with the
+# expected one under regression/ (<graph>.<run>.txt).
+#   integrated - dsabm_integrated: dsabm, pruned, forward, forward_pruned, topk and chop, with
+#                one and with four threads (same expected output)
+#   matrix, list, weighted - dsabm_slice with that backend: dsabm, and pruned on weighted
+#   list_fin   - dsabm_list_fin: dsabm
+# Every event stream regression/<case>.events is also fed to dsabm_integrated -e, its standard
+# output and error compared with regression/<case>.events.txt, and every update script
+# regression/<graph>.updates replayed with -u on that graph: its output is compared with
+# regression/<graph>.updates.txt and with the slices recomputed from scratch after each edit.
+# --update rewrites the expected outputs instead; --build compiles the front ends with g++ first.
+
+SOURCES = {'integrated': 'dsabm_integrated', 'slice': 'dsabm_slice', 'list_fin': 'dsabm_list_fin'}
+TAUS = (0.05, 0.2)
+
+def read_graph(path):
+    """Reads an ABDG text file: (vertices, edges as (tail, head, type) tuples)."""
+    with open(path) as fs:
+        tokens = fs.read().split()
+    n = int(tokens[0])
+    e = int(tokens[n + 1])
+    return tokens[1:n + 1], [tuple(tokens[n + 2 + 3 * i:n + 5 + 3 * i]) for i in range(e)]
+
+def read_nodes(path):
+    """Reads the vertex list of an ABDG text file."""
+    return read_graph(path)[0]
+
+def queries(nodes, modes):
+    """Batch queries of the given modes for every node (chops from every R to every J node)."""
+    lines = []
+    for v in nodes:
+        if 'dsabm' in modes:
+            lines.append(f"{v} 0 dsabm")
+        if 'pruned' in modes:
+            lines += [f"{v} {tau} pruned" for tau in TAUS]
+        if 'forward' in modes:
+            lines.append(f"{v} 0 forward")
+            lines += [f"{v} {tau} forward_pruned" for tau in TAUS]
+        if 'topk' in modes:
+            lines.append(f"{v} 3 topk")
+    if 'chop' in modes:
+        lines += [f"{u}:{v} 0 chop" for u in nodes if u[0] == 'R' for v in nodes if v[0] == 'J']
+    return "\n".join(lines) + "\n"
+
+def runs(exe, graph, work):
+    """(name, command) of every run on a graph; runs of the same name share their expected output."""
+    def query_file(name, modes):
+        path = os.path.join(work, name + '.txt')
+        with open(path, 'w') as fs:
+            fs.write(queries(read_nodes(graph), modes))
+        return path
+    all_modes = query_file('all', ('dsabm', 'pruned', 'forward', 'topk', 'chop'))
+    weighted = query_file('weighted', ('dsabm', 'pruned'))
+    unweighted = query_file('unweighted', ('dsabm',))
+    result = [('integrated', [exe['integrated'], '-t', str(threads), '-g', graph, all_modes]) for threads in (1, 4)]
+    result += [(backend, [exe['slice'], '-b', backend, '-g', graph, weighted if backend == 'weighted' else unweighted])
+               for backend in ('matrix', 'list', 'weighted')]
+    result.append(('list_fin', [exe['list_fin'], '-g', graph, unweighted]))
+    return result
+
+def check(cmd, expected_path, update, stderr=subprocess.PIPE):
+    """Runs cmd and compares (or, with update, replaces) its output with the expected one; True if it matches."""
+    output = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=stderr, text=True, check=True).stdout
+    if update:
+        with open(expected_path, 'w') as fs:
+            fs.write(output)
+        return True
+    with open(expected_path) as fs:
+        expected = fs.read()
+    if output == expected:
+        print(f"ok   {' '.join(cmd[:-1])}")
+        return True
+    print(f"FAIL {' '.join(cmd[:-1])}")
+    diff = difflib.unified_diff(expected.splitlines(), output.splitlines(), expected_path, 'output', lineterm='')
+    for line in list(diff)[:20]:
+        print(line)
+    return False
+
+def sorted_slices(output):
+    """Slice lines with the nodes of every slice sorted, to compare slices whatever their order."""
+    lines = []
+    for line in output.splitlines():
+        head, _, nodes = line.partition(' :')
+        lines.append(head + ' :' + ''.join(' ' + v for v in sorted(nodes.split())))
+    return lines
+
+def from_scratch(exe, graph, updates, work):
+    """The output of an update script recomputed by a batch run on the edited graph at every print."""
+    nodes, edges = read_graph(graph)
+    watches, output = [], []
+    with open(updates) as fs:
+        for line in fs:
+            words = line.split()
+            if not words or words[0].startswith('#'):
+                continue
+            if words[0] == 'watch':
+                watches.append(f"{words[1]} {words[2] if words[3] == 'pruned' else 0} {words[3]}")
+            elif words[0] == 'insert':
+                edges.append(tuple(words[1:4]))
+            elif words[0] == 'remove' and tuple(words[1:4]) in edges:
+                edges.remove(tuple(words[1:4]))
+            elif words[0] == 'print':
+                graph_path, query_path = os.path.join(work, 'edited.txt'), os.path.join(work, 'watches.txt')
+                with open(graph_path, 'w') as gs:
+                    gs.write(f"{len(nodes)}\n{' '.join(nodes)}\n{len(edges)}\n" + ''.join(' '.join(x) + '\n' for x in edges))
+                with open(query_path, 'w') as qs:
+                    qs.write(''.join(w + '\n' for w in watches))
+                cmd = [exe['integrated'], '-g', graph_path, query_path]
+                output += sorted_slices(subprocess.run(cmd, capture_output=True, text=True, check=True).stdout)
+    return output
+
+def build(exe, cxx):
+    for name, source in SOURCES.items():
+        cmd = [cxx, '-std=c++11', '-O2', '-pthread', '-o', exe[name], source + '.cpp']
+        print(' '.join(cmd))
+        subprocess.run(cmd, check=True)
+
+def main():
+    parser = argparse.ArgumentParser(description="Regression check of the DSABM batch front ends")
+    parser.add_argument('--update', action='store_true', help="rewrite the expected outputs")
+    parser.add_argument('--build', action='store_true', help="compile the front ends first")
+    parser.add_argument('--cxx', default='g++', help="--build: compiler")
+    parser.add_argument('--integrated', default='./dsabm_integrated')
+    parser.add_argument('--slice', default='./dsabm_slice')
+    parser.add_argument('--list-fin', default='./dsabm_list_fin')
+    parser.add_argument('--expected', default='regression', help="directory of the expected outputs")
+    args = parser.parse_args()
+    exe = {'integrated': args.integrated, 'slice': args.slice, 'list_fin': args.list_fin}
+    if args.build:
+        build(exe, args.cxx)
+
+    graphs = ['input_file.txt'] + sorted(g for g in glob.glob(os.path.join('Case Studies', '*.txt'))
+                                         if not g.endswith('_Calibration.txt'))
+    os.makedirs(args.expected, exist_ok=True)
+    failures = 0
+    with tempfile.TemporaryDirectory() as work:
+        for graph in graphs:
+            for name, cmd in runs(exe, graph, work):
+                expected_path = os.path.join(args.expected, f"{os.path.splitext(os.path.basename(graph))[0]}.{name}.txt")
+                failures += not check(cmd, expected_path, args.update)
+    for events in sorted(glob.glob(os.path.join(args.expected, '*.events'))):
+        failures += not check([exe['integrated'], '-e', events], events + '.txt', args.update, subprocess.STDOUT)
+    for updates in sorted(glob.glob(os.path.join(args.expected, '*.updates'))):
+        name = os.path.splitext(os.path.basename(updates))[0]
+        graph = next(g for g in graphs if os.path.splitext(os.path.basename(g))[0] == name)
+        cmd = [exe['integrated'], '-g', graph, '-u', updates]
+        failures += not check(cmd, updates + '.txt', args.update)
+        with tempfile.TemporaryDirectory() as work:
+            live = sorted_slices(subprocess.run(cmd, capture_output=True, text=True, check=True).stdout)
+            if live != from_scratch(exe, graph, updates, work):
+                failures += 1
+                print(f"FAIL {' '.join(cmd)}: the live slices differ from the ones recomputed from scratch")
+    if not args.update:
+        print(f"{failures} failure(s)")
+    return 1 if failures else 0
+
+if __name__ == '__main__':
+    sys.exit(main())
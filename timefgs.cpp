@@ -1,18 +1,20 @@
+// Timer self-check for bench_harness.h: the resolution of the clock and the cost the harness adds
+// to every measured call, i.e. the floor under any latency the slicers report
 #include <iostream>
-#include <ctime>
-
-void myFunction() {
-    for (volatile int i = 0; i < 1000000; ++i);
-}
+#include <chrono>
+#include "bench_harness.h"
 
 int main() {
-    clock_t start = clock();
-
-    myFunction();
+    // Smallest step of the clock
+    auto first = std::chrono::steady_clock::now(), next = first;
+    while (next == first) next = std::chrono::steady_clock::now();
+    std::cout << "Clock resolution: " << std::chrono::duration<double, std::nano>(next - first).count() << " nanoseconds" << std::endl;
 
-    clock_t end = clock();
-    double elapsed = double(end - start) / CLOCKS_PER_SEC; // Convert to seconds
-    std::cout << "Time taken: " << elapsed << " seconds" << std::endl;
+    BenchConfig config;
+    config.iterations = 10000;
+    PerfCounters counters;
+    print_bench_header(std::cout, config, pin_thread(config.cpu), counters);
+    print_bench_result(std::cout, "empty", bench([] {}, config, counters));
 
     return 0;
 }
\ No newline at end of file